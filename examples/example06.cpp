@@ -63,6 +63,7 @@ int main() {
         segyOutputFile.getTextualFileHeader() = segyFile.getTextualFileHeader();
         segyOutputFile.getBinaryFileHeader() = segyFile.getBinaryFileHeader();
         segyOutputFile.commitFileHeaderModifications(); // Write to file
+        segyOutputFile.setAppendMemoryBudget(64 << 20); // Write traces to disk in the background, 32 MB at a time
         for (size_t ii = 0; ii < segyFile.ntraces(); ++ii) {
             // Each trace may be manipulated here
             segyOutputFile.appendRawTrace(segyFile.readRawTrace(ii));
@@ -29,6 +29,7 @@
 #include<impl/SegyFile-TextualFileHeader.h>
 #include<impl/SegyFile-BinaryFileHeader.h>
 #include<impl/SegyFile-Trace.h>
+#include<impl/SegyFile-TraceView.h>
 
 // Enumerations and constants related to SEG Y standard
 #include<impl/SegyFile-constants.h>
@@ -36,16 +37,26 @@
 #include<boost/filesystem.hpp>
 #include<boost/filesystem/fstream.hpp>
 
+#include<functional>
+#include<future>
+#include<limits>
 #include<string>
 #include<memory>
 #include<utility>
+#include<vector>
 
 #include<cstddef>
 
 namespace seismic {
     
     class SegyFileIndexer;
+    class SegyFileBackend;
     class SegyFileLazyWriter;
+    class HeaderIndex;
+    class RegularGridHeaderIndex;
+    class HeaderColumns;
+    struct IndexSignature;
+    class SegyStreamReader;
     
     /**
      * @brief Models a file conforming to SEG Y rev 1 format
@@ -176,6 +187,15 @@ namespace seismic {
      * In the following it is shown how to __read a SEGY file, modify the traces and write them back to another file__:
      * @include example06.cpp
      * 
+     * Concurrent reads
+     * -----
+     * 
+     * With a thread-safe backend ("Positional" or "MemoryMapped") and an 
+     * indexer whose lookups do not touch the file stream ("InMemory", 
+     * "MappedFile" or "Computed"), readRawTrace, readTraceAs and viewTrace 
+     * (with a buffer per thread) may be called concurrently from several 
+     * threads on the same SegyFile, without locks. Writing operations still require exclusive access.
+     * 
      * @todo Add the possibility to choose indexer
      */
     class SegyFile {
@@ -186,15 +206,22 @@ namespace seismic {
         /// Trace header plus corresponding trace data of type T
         template <class T>
         using trace_type = Trace<T>;
+        
+        /// Function called on each trace header by scanTraceHeaders, with the index of the trace
+        using header_visitor_type = std::function< void (const size_t, const TraceHeaderView&) >;
 
         /**
          * @brief Opens an existing SEG Y file in r/w mode
          * 
          * @param[in] filename name of the SEG Y file to be read/written
          * @param[in] revision_tag type of SEG Y file to be created
+         * @param[in] indexer_tag type of indexer used for random access ("InMemory", "InFile", "MappedFile" or "Computed")
+         * @param[in] backend_tag type of backend used to read traces ("Stream", "MemoryMapped" or "Positional")
+         * @param[in] header_indexes secondary indexes, built during the same pass as the index
          * 
          */
-        SegyFile(const char * filename, const std::string & revision_tag = "Rev0", const std::string & indexer_tag = "InMemory");
+        SegyFile(const char * filename, const std::string & revision_tag = "Rev0", const std::string & indexer_tag = "InMemory", const std::string & backend_tag = "Stream",
+                const std::vector< std::shared_ptr<HeaderIndex> >& header_indexes = std::vector< std::shared_ptr<HeaderIndex> >());
         
         /**
          * @brief Returns the textual file header
@@ -251,6 +278,80 @@ namespace seismic {
          */
         raw_trace_type readRawTrace(const size_t n);
         
+        /**
+         * @brief Reads a trace from file into an existing raw trace
+         * 
+         * The trace header object and the capacity of the trace data are 
+         * reused, so that reading every trace of a file into the same object
+         * allocates memory only when a trace is longer than the previous ones.
+         * The trace header is overwritten in place, and so are the copies 
+         * that share it. A trace without header (e.g. default constructed) 
+         * receives a new one, while an existing header must have the same 
+         * revision of the file.
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] n index of the trace to be read
+         * @param[in,out] trace trace header and trace data
+         */
+        void readRawTraceInto(const size_t n, raw_trace_type& trace);
+        
+        /**
+         * @brief Returns a non-owning view over a trace
+         * 
+         * Requires a backend that holds the file in memory (e.g. "MemoryMapped").
+         * The view is invalidated by the next call to commitTraceModifications()
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] n index of the trace to be viewed
+         * @return view over trace header and trace data
+         */
+        TraceView viewTrace(const size_t n);
+        
+        /**
+         * @brief Returns a non-owning view over a trace
+         * 
+         * If the backend does not hold the file in memory, the bytes of the 
+         * trace are read into a buffer supplied by the caller, whose capacity
+         * is reused across calls. The view is invalidated by any modification
+         * of the buffer, or by the next call to commitTraceModifications()
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] n index of the trace to be viewed
+         * @param[in,out] buffer storage for the trace bytes, if needed
+         * @return view over trace header and trace data
+         */
+        TraceView viewTrace(const size_t n, std::vector<char>& buffer);
+        
+        /**
+         * @brief Visits the trace headers, without reading trace data
+         * 
+         * With a backend that holds the file in memory, headers are visited 
+         * in place. Otherwise only the 240 bytes of each header are read, 
+         * unless traces are so short that reading a whole window of them is 
+         * cheaper. The views passed to the visitor are valid only for the 
+         * duration of the call.
+         * 
+         * Example:
+         * @code
+         * int32_t xmin = std::numeric_limits<int32_t>::max();
+         * segyFile.scanTraceHeaders([&xmin](size_t n, const TraceHeaderView& header) {
+         *     xmin = std::min(xmin, header[rev0::th::sourceCoordinateX]);
+         * });
+         * @endcode
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] visitor function called on each trace header
+         * @param[in] first index of the first trace to be visited
+         * @param[in] last index past the last trace to be visited (by default, 
+         * the headers are visited up to the end of the file)
+         */
+        void scanTraceHeaders(const header_visitor_type& visitor, const size_t first = 0, 
+                              const size_t last = std::numeric_limits<size_t>::max());
+        
         /**
          * @brief Appends a trace to the end of the SEG Y file
          * 
@@ -258,6 +359,22 @@ namespace seismic {
          */
         void appendRawTrace(const raw_trace_type& trace);
         
+        /**
+         * @brief Bounds the memory used to queue appended traces
+         * 
+         * By default appended traces are kept in memory until the next 
+         * commit. With a budget, they are written to the end of the file in 
+         * chunks of about half the budget by a background thread, while the 
+         * following traces are being encoded. The queue then takes at most 
+         * the budget plus two traces of 65535 samples (about 512 kB), 
+         * allocated upfront: one chunk being written and one being encoded. 
+         * The bound holds for the traces appended after the call. Flushed 
+         * traces become visible only after commitTraceModifications().
+         * 
+         * @param[in] bytes memory budget in bytes (0 means no bound)
+         */
+        void setAppendMemoryBudget(const size_t bytes);
+        
         /**
          * @brief Overwrites a trace at position n
          * 
@@ -266,6 +383,46 @@ namespace seismic {
          */
         void overwriteRawTrace(const raw_trace_type& trace, const size_t n);
         
+        /**
+         * @brief Overwrites the header of the trace at position n
+         * 
+         * Only the header bytes are written when modifications are 
+         * committed: the trace data is neither read nor rewritten. The number
+         * of samples must not change.
+         * 
+         * @param[in] header trace header to be written
+         * @param[in] n index of the trace whose header is overwritten
+         */
+        void overwriteTraceHeader(const TraceHeader::smart_reference_type& header, const size_t n);
+        
+        /**
+         * @brief Writes the fields stored in a set of columns into the trace
+         * headers of a range of traces
+         * 
+         * Row ii of the columns is written into the header of trace first + ii.
+         * Other header fields and trace data are left untouched. A column 
+         * may hold the number of samples, as long as it does not change it.
+         * 
+         * The headers are patched in the overwrite queue, on top of the 
+         * modifications already queued for them, and every queued 
+         * modification is then committed: headers close to each other in 
+         * the file are written in a single run.
+         * 
+         * Example:
+         * @code
+         * HeaderColumns geometry;
+         * geometry.add(rev1::th::sourceCoordinateX);
+         * geometry.add(rev1::th::sourceCoordinateY);
+         * geometry.resize(segyFile.ntraces());
+         * // ... fill geometry[rev1::th::sourceCoordinateX] and geometry[rev1::th::sourceCoordinateY]
+         * segyFile.overwriteHeaderColumns(geometry);
+         * @endcode
+         * 
+         * @param[in] columns values of the fields to be written
+         * @param[in] first index of the first trace to be patched
+         */
+        void overwriteHeaderColumns(const HeaderColumns& columns, const size_t first = 0);
+        
         /**
          * @brief Reads a trace from file
          * 
@@ -277,6 +434,87 @@ namespace seismic {
         template<class T>
         Trace<T> readTraceAs(const size_t n);
         
+        /**
+         * @brief Reads a trace from file into an existing trace
+         * 
+         * The trace header object and the capacity of the trace are reused, 
+         * so that reading every trace of a file into the same object 
+         * allocates memory only when a trace is longer than the previous ones.
+         * The trace header is overwritten in place, and so are the copies 
+         * that share it. A trace without header (e.g. built from a default 
+         * constructed reference) receives a new one, while an existing header
+         * must have the same revision of the file.
+         * 
+         * Example:
+         * @code
+         * auto trace = segyFile.readTraceAs<float>(0);
+         * for (size_t ii = 1; ii < segyFile.ntraces(); ++ii) {
+         *     segyFile.readTraceInto(ii, trace);
+         * }
+         * @endcode
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] n index of the trace to be read
+         * @param[in,out] trace seismic trace (header + data)
+         */
+        template<class T>
+        void readTraceInto(const size_t n, Trace<T>& trace);
+        
+        /**
+         * @brief Starts reading a trace from file
+         * 
+         * The read is handed to the backend, and the returned future becomes 
+         * ready once the trace has been read and decoded. With the "Async" 
+         * backend many reads can be kept in flight at once, which is what 
+         * random access patterns need to exploit fast storage. Other 
+         * backends read synchronously.
+         * 
+         * Example:
+         * @code
+         * std::vector< std::future< Trace<float> > > pending;
+         * for (auto n : picks) {
+         *     pending.push_back(segyFile.readTraceAsync<float>(n));
+         * }
+         * for (auto& trace : pending) {
+         *     process(trace.get());
+         * }
+         * @endcode
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] n index of the trace to be read
+         * 
+         * @return the future seismic trace (header + data)
+         */
+        template<class T>
+        std::future< Trace<T> > readTraceAsync(const size_t n);
+        
+        /**
+         * @brief Reads a contiguous range of traces from file
+         * 
+         * The range is fetched with a single I/O operation (or directly from 
+         * memory, if the backend allows it) and decoded into a buffer of 
+         * count x stride values provided by the caller: trace ii is stored 
+         * starting at samples + ii * stride. Traces shorter than stride are 
+         * padded with zeros.
+         * 
+         * If headers is not null, it must hold count x TraceHeader::buffer_size 
+         * bytes: it receives the trace headers, as they are stored in the file 
+         * (i.e. in big-endian byte order). Each of them can be accessed via a 
+         * TraceHeaderView.
+         * 
+         * Indexes are zero-based
+         * 
+         * @param[in] first index of the first trace to be read
+         * @param[in] count number of traces to be read
+         * @param[out] samples buffer that will receive the samples
+         * @param[in] stride distance between the first samples of two consecutive traces in the buffer
+         * @param[out] headers buffer that will receive the trace headers (optional)
+         */
+        template<class T>
+        void readTracesAs(const size_t first, const size_t count, T * samples, const size_t stride, char * headers = nullptr);
+        
         /**
          * @brief Appends a trace to the end of the SEG Y file
          * 
@@ -294,6 +532,133 @@ namespace seismic {
         template<class T>
         void overwriteTrace(const Trace<T>& trace, const size_t n);
                 
+        /**
+         * @brief Attaches a secondary index to an open SEG Y file
+         * 
+         * The headers of the traces already in the file are read to build the
+         * index. The index is kept up to date when traces are appended or 
+         * overwritten.
+         * 
+         * Example:
+         * @code
+         * auto lines = std::make_shared<SortedHeaderIndex>(HeaderKey(rev1::th::inlineNumber, rev1::th::crosslineNumber));
+         * segyFile.attachHeaderIndex(lines);
+         * for (auto n : lines->findFirst(121)) {
+         *     auto trace = segyFile.readTraceAs<float>(n);
+         * }
+         * @endcode
+         * 
+         * @param[in] index secondary index
+         */
+        void attachHeaderIndex(const std::shared_ptr<HeaderIndex>& index);
+        
+        /**
+         * @brief Returns the inline/crossline lattice detected while indexing
+         * 
+         * The lattice is the one of the first RegularGridHeaderIndex among 
+         * the secondary indexes: its first field is taken as the inline 
+         * number, its second field as the crossline number. Traces may be 
+         * sorted either by inline or by crossline, and cells of the lattice 
+         * may be missing.
+         * 
+         * Example:
+         * @code
+         * auto grid = std::make_shared<RegularGridHeaderIndex>(HeaderKey(rev1::th::inlineNumber, rev1::th::crosslineNumber));
+         * SegyFile segyFile(filename, "Rev1", "InMemory", "Stream", {grid});
+         * auto nsamples = segyFile.getBinaryFileHeader()[rev0::bfh::nsamplesDataTrace];
+         * std::vector<float> line(grid->second().size() * nsamples);
+         * segyFile.readInlineAs(121, line.data(), nsamples);
+         * @endcode
+         * 
+         * @return secondary index holding the lattice
+         */
+        const RegularGridHeaderIndex& geometry() const;
+        
+        /**
+         * @brief Returns the index of the trace at a given inline and crossline
+         * 
+         * @param[in] il inline number
+         * @param[in] xl crossline number
+         * @return index of the trace
+         */
+        size_t traceIndex(const int32_t il, const int32_t xl) const;
+        
+        /**
+         * @brief Reads an inline
+         * 
+         * The buffer must hold geometry().second().size() x stride values: 
+         * the trace at the k-th crossline of the lattice is stored starting 
+         * at samples + k * stride. Missing traces are filled with zeros.
+         * 
+         * @param[in] il inline number
+         * @param[out] samples buffer that will receive the samples
+         * @param[in] stride distance between the first samples of two consecutive traces in the buffer
+         */
+        template<class T>
+        void readInlineAs(const int32_t il, T * samples, const size_t stride);
+        
+        /**
+         * @brief Reads a crossline
+         * 
+         * The buffer must hold geometry().first().size() x stride values: 
+         * the trace at the k-th inline of the lattice is stored starting at 
+         * samples + k * stride. Missing traces are filled with zeros.
+         * 
+         * @param[in] xl crossline number
+         * @param[out] samples buffer that will receive the samples
+         * @param[in] stride distance between the first samples of two consecutive traces in the buffer
+         */
+        template<class T>
+        void readCrosslineAs(const int32_t xl, T * samples, const size_t stride);
+        
+        /**
+         * @brief Reads a time slice
+         * 
+         * The buffer must hold geometry().first().size() x 
+         * geometry().second().size() values, crosslines varying fastest. 
+         * Missing traces, and traces shorter than the requested sample, 
+         * contribute zeros.
+         * 
+         * @param[in] sample index of the sample (zero-based)
+         * @param[out] values buffer that will receive the slice
+         */
+        template<class T>
+        void readTimeSliceAs(const size_t sample, T * values);
+        
+        /**
+         * @brief Reads the columns of trace header fields
+         * 
+         * Only the trace headers are read, for the traces whose fields are not
+         * yet recorded in the columns. Columns are not updated by later 
+         * modifications to the file.
+         * 
+         * @param[in,out] columns set of columns to be filled
+         */
+        void readHeaderColumns(HeaderColumns& columns);
+        
+        /**
+         * @brief Reads the columns of trace header fields, reusing a cache file
+         * 
+         * The columns stored in the cache are reused if they were read from 
+         * the same SEG-Y file (possibly with traces appended since then), and
+         * if they hold the same set of fields. Otherwise they are read again.
+         * The cache is rewritten whenever the columns change.
+         * 
+         * If traces have been appended, the headers the cached columns were 
+         * read from are checked against checksums stored in the cache, as 
+         * they may have been patched in place too: reusing the cache then 
+         * costs a scan of the headers, but no decoding.
+         * 
+         * Example:
+         * @code
+         * segyFile.readHeaderColumns(columns, segyFile.path().string() + ".columns");
+         * @endcode
+         * 
+         * @param[in,out] columns set of columns to be filled
+         * @param[in] cache path of the cache file
+         */
+        void readHeaderColumns(HeaderColumns& columns, const boost::filesystem::path& cache);
+        
         /**
          * @brief Returns the revision tag for the given SEG Y file
          * 
@@ -318,6 +683,9 @@ namespace seismic {
         ~SegyFile();
 
     private:
+        /// Plans its reads on the indexer, and decodes traces as readTraceInto does
+        friend class SegyStreamReader;
+        
         //////////
         // Helper methods
         //////////
@@ -328,6 +696,18 @@ namespace seismic {
         template<class T>
         raw_trace_type convertToRawType(const Trace<T>& trace);
         
+        /// Reads the headers of the traces not yet recorded by secondary indexes, and updates them
+        void updateHeaderIndexes();
+        
+        /// Computes the signature of the SEG Y file, as seen by the first n traces
+        IndexSignature headerSignature(const size_t n);
+        
+        /// Checks if the headers the columns were read from still match a signature
+        bool matchesSignature(const IndexSignature& signature, const HeaderColumns& columns);
+        
+        /// Converts a trace header from big-endian to native byte order (source may be equal to destination)
+        void decodeTraceHeader(const char * source, char * destination) const;
+        
         //////////
         // File related information
         //////////
@@ -336,11 +716,19 @@ namespace seismic {
         std::shared_ptr<TextualFileHeader> tfh_;
         std::shared_ptr<BinaryFileHeader> bfh_;
         const std::string tag_;
+        /// Trace header of the given revision, resolved once and cloned for each trace that is read
+        TraceHeader::handle_type thPrototype_;
+        /// Byte order permutation of the trace headers, applied without virtual dispatch
+        const ByteOrderPermutation<TraceHeader::buffer_size> * thPermutation_;
         //////////
         // Indexer
         //////////
         std::shared_ptr<SegyFileIndexer> indexer_;
         //////////
+        // Read backend
+        //////////
+        std::shared_ptr<SegyFileBackend> backend_;
+        //////////
         // Lazy writer
         //////////
         std::shared_ptr<SegyFileLazyWriter> writer_;                
@@ -27,16 +27,25 @@
 #define	GENERICBYTESTREAM_INL_H
 
 #include<impl/ObjectFactory-inl.h>
+#include<impl/metafunctions-inl.h>
+#include<impl/utilities-inl.h>
 
 #include<array>
+#include<cstdint>
 #include<iostream>
 #include<memory>
+#include<sstream>
+#include<stdexcept>
+#include<vector>
 
 namespace seismic {
     
     template<int size>
     class GenericByteStreamSmartReference;
     
+    template<int size>
+    class ByteOrderPermutation;
+    
     /**
      * @brief Interface to a generic byte stream of known size
      * 
@@ -113,6 +122,19 @@ namespace seismic {
          */
         virtual void invertByteOrder() = 0;
         
+        /**
+         * @brief Returns the permutation applied by invertByteOrder(), if the
+         * stream has one
+         * 
+         * Lets callers that decode many streams of the same kind resolve the
+         * permutation once, and apply it without virtual dispatch.
+         * 
+         * @return pointer to a static permutation, or nullptr
+         */
+        virtual const ByteOrderPermutation<size> * byteOrderPermutation() {
+            return nullptr;
+        }
+        
         /**
          * @brief Check if the values of mandatory fields are set, and throws exceptions if
          * a non-conformity is detected
@@ -128,6 +150,86 @@ namespace seismic {
         std::array<char,size> buffer_;
     };
          
+    /**
+     * @brief Permutation of the bytes of a stream that inverts the byte order 
+     * of a set of fields
+     * 
+     * Built once from the layout of a header, it inverts the byte order of 
+     * all its fields in a single pass over the stream, instead of a loop 
+     * over the fields. Bytes that do not belong to any field are left 
+     * untouched. Fields must not straddle a 16-byte boundary, which is the 
+     * case for the naturally aligned fields of SEG Y headers.
+     * 
+     * @tparam size stream size in bytes (a multiple of 16)
+     */
+    template<int size>
+    class ByteOrderPermutation {
+        static_assert(size % 16 == 0, "The size of a permuted stream must be a multiple of 16");
+    public:
+        ByteOrderPermutation() {
+            for (int ii = 0; ii < size; ++ii) {
+                m_permutation[ii] = static_cast<uint8_t>(ii % 16);
+            }
+        }
+        
+        /**
+         * @brief Adds a field to the permutation
+         * 
+         * @param[in] field field whose byte order must be inverted
+         * @return the permutation itself
+         */
+        template<class T>
+        ByteOrderPermutation& add(const Field<T>& field) {
+            const long long int first = field.value_;
+            const long long int last = field.value_ + static_cast<long long int>(sizeof(T)) - 1;
+            if (first < 0 || last >= size || first / 16 != last / 16) {
+                std::stringstream estream;
+                estream << "Byte order error : the field at byte " << first << " can't be permuted" << std::endl;
+                throw std::runtime_error(estream.str());
+            }
+            for (long long int ii = first; ii <= last; ++ii) {
+                m_permutation[ii] = static_cast<uint8_t>( (first + last - ii) % 16 );
+            }
+            return *this;
+        }
+        
+        /**
+         * @brief Adds a list of fields to the permutation
+         * 
+         * @param[in] fields fields whose byte order must be inverted
+         * @return the permutation itself
+         */
+        template<class T>
+        ByteOrderPermutation& add(const std::vector< Field<T> >& fields) {
+            for (const auto& x : fields) {
+                add(x);
+            }
+            return *this;
+        }
+        
+        /**
+         * @brief Permutes a stream in place
+         * 
+         * @param[in,out] stream pointer to the first byte of the stream
+         */
+        void apply(char * stream) const {
+            permuteBytes(stream, stream, m_permutation.data(), size);
+        }
+        
+        /**
+         * @brief Permutes a stream into another
+         * 
+         * @param[in] source pointer to the first byte of the stream
+         * @param[out] destination pointer to the first byte of the permuted stream
+         */
+        void apply(const char * source, char * destination) const {
+            permuteBytes(source, destination, m_permutation.data(), size);
+        }
+        
+    private:
+        std::array<uint8_t, size> m_permutation;
+    };
+    
     /**
      * @brief Read a byte stream from an input stream
      * 
@@ -190,6 +292,15 @@ namespace seismic {
         template<class T>
         explicit GenericByteStreamSmartReference( T ptr ) : ptr_(ptr) {}
         
+        /**
+         * @brief Checks if the reference manages a byte stream
+         * 
+         * @return true if a byte stream is managed, false otherwise
+         */
+        explicit operator bool() const {
+            return static_cast<bool>(ptr_);
+        }
+        
         /**
          * @brief Returns a reference to the underlying bytes interpreted as the correct type
          * 
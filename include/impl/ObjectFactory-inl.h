@@ -26,6 +26,8 @@
 #ifndef OBJECTFACTORY_INL_H
 #define	OBJECTFACTORY_INL_H
 
+#include<impl/RecyclingAllocator-inl.h>
+
 #include<map>
 #include<iostream>
 #include<stdexcept>
@@ -157,6 +159,15 @@ namespace seismic {
         handle_type create() const override { \
             return std::make_shared<concrete_type>(); \
         }
+
+/**
+ * @brief Adds a concrete create method stemming from default constructor, 
+ * whose memory is recycled (for types that are created at a high rate)
+ */
+#define FACTORY_ADD_RECYCLING_CREATE(T) using concrete_type = T; \
+        handle_type create() const override { \
+            return std::allocate_shared<concrete_type>( RecyclingAllocator<concrete_type>() ); \
+        }
 }
 
 #endif	/* OBJECTFACTORY_INL_H */
@@ -0,0 +1,154 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file RecyclingAllocator-inl.h
+ * @brief Allocator that recycles the memory of single objects
+ */
+#ifndef RECYCLINGALLOCATOR_INL_H
+#define	RECYCLINGALLOCATOR_INL_H
+
+#include<cstddef>
+#include<new>
+
+namespace seismic {
+    
+    /**
+     * @brief Allocator that keeps the memory of deallocated objects in a 
+     * per-thread free list, and hands it out again on the next allocation
+     * 
+     * Meant for small objects that are created and destroyed at a high rate,
+     * like the trace headers returned by SegyFile: in steady state an 
+     * allocation costs a couple of pointer swaps, without locks. Only 
+     * allocations of a single object are recycled, and each thread keeps at 
+     * most max_free_blocks blocks per type, that are returned to the system 
+     * when the thread ends. A block deallocated by a thread other than the 
+     * one that allocated it joins the list of the deallocating thread.
+     * 
+     * @tparam T type of the allocated objects
+     */
+    template<class T>
+    class RecyclingAllocator {
+    public:
+        using value_type = T;
+        
+        /// Maximum number of blocks kept by each thread
+        static const size_t max_free_blocks = 64;
+        
+        RecyclingAllocator() {
+        }
+        
+        template<class U>
+        RecyclingAllocator(const RecyclingAllocator<U>&) {
+        }
+        
+        /**
+         * @brief Allocates uninitialized storage
+         * 
+         * @param[in] n number of objects
+         * @return pointer to the storage
+         */
+        T * allocate(const size_t n) {
+            auto& list = freeList();
+            if (n == 1 && list.head != nullptr) {
+                auto block = list.head;
+                list.head = block->next;
+                --list.size;
+                return reinterpret_cast<T *>(block);
+            }
+            return static_cast<T *>( ::operator new(n * sizeof (T)) );
+        }
+        
+        /**
+         * @brief Deallocates storage
+         * 
+         * @param[in] p pointer to the storage
+         * @param[in] n number of objects
+         */
+        void deallocate(T * p, const size_t n) {
+            auto& list = freeList();
+            if (n == 1 && list.size < max_free_blocks) {
+                list.head = new (p) Block{list.head};
+                ++list.size;
+                return;
+            }
+            ::operator delete(p);
+        }
+        
+    private:
+        struct Block {
+            Block * next;
+        };
+        
+        static_assert(sizeof (T) >= sizeof (Block), "Objects are too small to be recycled");
+        
+        /// Trivially destructible, so that it may still be used after the thread's drain has run
+        struct FreeList {
+            Block * head;
+            size_t size;
+        };
+        
+        /**
+         * @brief Returns the blocks of the thread to the system when the 
+         * thread ends
+         * 
+         * The list is left empty and full, so that objects destroyed later 
+         * by the same thread (e.g. owned by statics or by other thread-local 
+         * objects) are deallocated directly.
+         */
+        struct Drain {
+            ~Drain() {
+                auto& list = list_;
+                while (list.head != nullptr) {
+                    auto block = list.head;
+                    list.head = block->next;
+                    ::operator delete(block);
+                }
+                list.size = max_free_blocks;
+            }
+        };
+        
+        static FreeList& freeList() {
+            // Constructed by the first use on each thread, so that the list is drained when the thread ends
+            static thread_local Drain drain;
+            (void) drain;
+            return list_;
+        }
+        
+        static thread_local FreeList list_;
+    };
+    
+    template<class T>
+    thread_local typename RecyclingAllocator<T>::FreeList RecyclingAllocator<T>::list_ = {nullptr, 0};
+    
+    template<class T, class U>
+    inline bool operator==(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) {
+        return true;
+    }
+    
+    template<class T, class U>
+    inline bool operator!=(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) {
+        return false;
+    }
+    
+}
+
+#endif	/* RECYCLINGALLOCATOR_INL_H */
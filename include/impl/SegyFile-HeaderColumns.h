@@ -0,0 +1,249 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SegyFile-HeaderColumns.h
+ * @brief Columnar cache of trace header fields
+ */
+#ifndef SEGYFILE_HEADERCOLUMNS_H
+#define	SEGYFILE_HEADERCOLUMNS_H
+
+#include<impl/indexer/IndexSignature-inl.h>
+#include<impl/metafunctions-inl.h>
+
+#include<boost/filesystem.hpp>
+
+#include<cstdint>
+#include<vector>
+
+namespace seismic {
+    
+    /**
+     * @brief Values of a set of trace header fields for every trace, stored 
+     * column by column
+     * 
+     * Each field is widened to a 32 bits integer and stored in a contiguous
+     * array indexed by trace id. Sorting, quality control of the geometry 
+     * and statistics may then be performed as scans over arrays, instead of 
+     * reading the headers one by one.
+     * 
+     * Columns are filled by SegyFile::readHeaderColumns, which may also 
+     * persist them in a file next to the SEG-Y file.
+     * 
+     * Example:
+     * @code
+     * HeaderColumns columns;
+     * columns.add(rev1::th::inlineNumber);
+     * columns.add(rev1::th::crosslineNumber);
+     * segyFile.readHeaderColumns(columns);
+     * const auto& inlines = columns[rev1::th::inlineNumber];
+     * auto range = std::minmax_element(inlines.begin(), inlines.end());
+     * @endcode
+     */
+    class HeaderColumns {
+    public:
+        /// Values of a field, by trace id
+        using column_type = std::vector<int32_t>;
+        
+        /// Identifies a file of header columns ("SGYC")
+        static const uint32_t magic_number = 0x43594753;
+        /// Version of the columns format, to be bumped on any change to the layout
+        static const uint32_t current_version = 2;
+        /// Number of consecutive traces covered by each checksum of their headers
+        static const size_t checksum_block = 1024;
+        
+        HeaderColumns();
+        
+        /**
+         * @brief Adds a field to the set of columns
+         * 
+         * Values already read are dropped, as the new column would be empty
+         * 
+         * @param[in] field field (Int32Field or Int16Field)
+         * @return position of the column
+         */
+        template<class T>
+        size_t add(const Field<T>& field) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 2, "Only Int32Field and Int16Field can be stored in a column");
+            return add(Component{field.value_, sizeof(T)});
+        }
+        
+        /**
+         * @brief Checks if a field has been added to the set of columns
+         * 
+         * @param[in] field field (Int32Field or Int16Field)
+         * @return true if a column holds the field, false otherwise
+         */
+        template<class T>
+        bool contains(const Field<T>& field) const {
+            return contains(Component{field.value_, sizeof(T)});
+        }
+        
+        /**
+         * @brief Returns the number of columns
+         * 
+         * @return number of columns
+         */
+        size_t ncolumns() const;
+        
+        /**
+         * @brief Returns the number of traces whose fields have been recorded
+         * 
+         * @return number of traces
+         */
+        size_t size() const;
+        
+        /**
+         * @brief Returns the column of a field
+         * 
+         * @param[in] field field that has been added to the set of columns
+         * @return values of the field, by trace id
+         */
+        template<class T>
+        const column_type& operator[](const Field<T>& field) const {
+            return column(find(Component{field.value_, sizeof(T)}));
+        }
+        
+        /**
+         * @brief Returns the column of a field, for modification
+         * 
+         * The length of the column must not be changed
+         * 
+         * @param[in] field field that has been added to the set of columns
+         * @return values of the field, by trace id
+         */
+        template<class T>
+        column_type& operator[](const Field<T>& field) {
+            return column(find(Component{field.value_, sizeof(T)}));
+        }
+        
+        /**
+         * @brief Returns a column by position
+         * 
+         * @param[in] ii position of the column
+         * @return values of the field, by trace id
+         */
+        const column_type& column(const size_t ii) const;
+        
+        /**
+         * @brief Returns a column by position, for modification
+         * 
+         * The length of the column must not be changed
+         * 
+         * @param[in] ii position of the column
+         * @return values of the field, by trace id
+         */
+        column_type& column(const size_t ii);
+        
+        /**
+         * @brief Returns the checksums of the trace headers the columns were 
+         * read from
+         * 
+         * Checksum ii covers the headers of traces [ii * checksum_block, 
+         * (ii + 1) * checksum_block), as computed by IndexSignature::checksum.
+         * There are no checksums if the columns were not filled by push_back.
+         * 
+         * @return checksums of the trace headers
+         */
+        const std::vector<uint64_t>& checksums() const;
+        
+        /**
+         * @brief Records the fields of trace size()
+         * 
+         * @param[in] header trace header, in big-endian byte order
+         */
+        void push_back(const char * header);
+        
+        /**
+         * @brief Writes the fields of a trace into a trace header
+         * 
+         * Values of Int16Field columns are truncated to 16 bits. The other 
+         * bytes of the header are left untouched.
+         * 
+         * @param[in] n position of the trace in the columns
+         * @param[in,out] header trace header, in big-endian byte order
+         */
+        void store(const size_t n, char * header) const;
+        
+        /**
+         * @brief Sets the number of traces, so that columns may be filled 
+         * without reading them from a file
+         * 
+         * New values are zero. Checksums of the trace headers are dropped.
+         * 
+         * @param[in] ntraces number of traces
+         */
+        void resize(const size_t ntraces);
+        
+        /**
+         * @brief Forgets the values of every column, keeping the set of fields
+         */
+        void clear();
+        
+        /**
+         * @brief Writes the columns to a file
+         * 
+         * The magic number and version of the signature are replaced by 
+         * those of the columns format.
+         * 
+         * @param[in] path path of the file
+         * @param[in] signature state of the SEG-Y file the columns were read from
+         */
+        void save(const boost::filesystem::path& path, const IndexSignature& signature) const;
+        
+        /**
+         * @brief Reads the columns from a file
+         * 
+         * Nothing is read if the file does not exist, was written in another 
+         * version of the columns format, or stores a different set of fields
+         * 
+         * @param[in] path path of the file
+         * @param[out] signature state of the SEG-Y file the columns were read from
+         * @return true if the columns have been read, false otherwise
+         */
+        bool load(const boost::filesystem::path& path, IndexSignature& signature);
+        
+    private:
+        /// Offset and size of a field
+        struct Component {
+            long long int offset;
+            uint64_t size;
+            
+            bool operator==(const Component& other) const {
+                return offset == other.offset && size == other.size;
+            }
+        };
+        
+        size_t add(const Component& component);
+        
+        size_t find(const Component& component) const;
+        
+        bool contains(const Component& component) const;
+        
+        std::vector<Component> m_fields;
+        std::vector<column_type> m_columns;
+        size_t m_size;
+        std::vector<uint64_t> m_checksums;
+    };
+    
+}
+
+#endif	/* SEGYFILE_HEADERCOLUMNS_H */
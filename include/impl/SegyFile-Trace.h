@@ -47,6 +47,9 @@ namespace seismic {
         /**
          * @brief Construct an empty trace from a trace header pointer
          * 
+         * The pointer may be empty: the trace then receives a header when it
+         * is read from a file
+         * 
          * @param[in] th pointer to a trace header
          */
         Trace(TraceHeader::smart_reference_type th) : TraceHeader::smart_reference_type(th) {
@@ -77,6 +80,18 @@ namespace seismic {
             updateNumberOfSamples();
         }
         
+        /**
+         * @brief Changes the number of samples in the trace
+         * 
+         * The capacity of the trace is never reduced
+         * 
+         * @param[in] nsamples number of samples
+         */
+        void resize(const size_t nsamples) {
+            std::vector<T>::resize(nsamples);
+            updateNumberOfSamples();
+        }
+        
         /// @todo HIDE ALL THE OTHER FUNCTIONS THAT ADD REMOVE ELEMENTS
         
         /**
@@ -95,6 +110,9 @@ namespace seismic {
          * @brief Updates the number of samples stored in the trace header
          */
         void updateNumberOfSamples() {
+            if (!static_cast<const TraceHeader::smart_reference_type&>(*this)) {
+                return;
+            }
             (*this)[rev0::th::nsamplesTrace] = this->size();
         }
     };
@@ -106,9 +124,7 @@ namespace seismic {
         inputStream.read(reinterpret_cast<char*>(trace.data()), nSamples * sizeOfDataSample);
 #ifdef LITTLE_ENDIAN
         // If the system is little endian, bytes must be swapped
-        for( auto& x : trace ) {
-            invertByteOrder(x);
-        }        
+        swapByteOrder(reinterpret_cast<char*>(trace.data()), trace.size(), sizeof(typename Trace<T>::value_type));
 #endif  
     }
 
@@ -49,18 +49,14 @@ namespace seismic {
         inputStream.read(td.data(), nSamples * sizeOfDataSample);
 #ifdef LITTLE_ENDIAN
         // If the system is little endian, bytes must be swapped
-        for (size_t ii = 0; ii < nSamples; ii++) {
-            invertByteOrder(&td[ii * sizeOfDataSample], sizeOfDataSample);
-        }
+        swapByteOrder(td.data(), nSamples, sizeOfDataSample);
 #endif  
     }
     
     inline void write(std::ostream& outputStream, trace_data_type td, size_t nSamples, size_t sizeOfDataSample) {
 #ifdef LITTLE_ENDIAN
         // If the system is little endian, bytes must be swapped
-        for (size_t ii = 0; ii < nSamples; ii++) {
-            invertByteOrder(&td[ii * sizeOfDataSample], sizeOfDataSample);
-        }
+        swapByteOrder(td.data(), nSamples, sizeOfDataSample);
 #endif  
         outputStream.write(td.data(),nSamples*sizeOfDataSample);        
     }
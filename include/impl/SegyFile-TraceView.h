@@ -0,0 +1,233 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SegyFile-TraceView.h
+ * @brief Non-owning views over the raw bytes of a SEG-Y trace
+ */
+#ifndef SEGYFILE_TRACEVIEW_H
+#define	SEGYFILE_TRACEVIEW_H
+
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/SegyFile-constants.h>
+#include<impl/utilities-inl.h>
+#include<impl/rev0/SegyFile-Fields-Rev0.h>
+
+#include<cstdint>
+#include<sstream>
+#include<stdexcept>
+#include<typeinfo>
+#include<type_traits>
+
+namespace seismic {
+
+    /**
+     * @brief Read-only view over the 240 bytes of a trace header, as they 
+     * are stored in a SEG-Y file
+     * 
+     * Fields are decoded from big-endian byte order on access. The view does 
+     * not own the underlying bytes, which must outlive it.
+     */
+    class TraceHeaderView {
+    public:
+        TraceHeaderView() : m_data(nullptr) {
+        }
+        
+        /**
+         * @brief Constructs a view over a trace header stored in big-endian byte order
+         * 
+         * @param[in] data pointer to the first byte of the trace header
+         */
+        explicit TraceHeaderView(const char * data) : m_data(data) {
+        }
+        
+        /**
+         * @brief Returns the value of a field in native byte order
+         * 
+         * @tparam T subscript type
+         * 
+         * @param[in] id value associated with the requested field
+         * @return value of the requested field
+         */
+        template<class T>
+        typename T::type operator[](T const id) const {
+            return readBigEndian<typename T::type>(m_data + id.value_);
+        }
+        
+        /**
+         * @brief Returns a raw pointer to the underlying bytes
+         * 
+         * @return pointer to the beginning of the trace header
+         */
+        const char * get() const {
+            return m_data;
+        }
+        
+    private:
+        const char * m_data;
+    };
+    
+    /**
+     * @brief Read-only view over a whole SEG-Y trace (header + data), as it 
+     * is stored in a SEG-Y file
+     * 
+     * Samples are decoded on access, converting IBM floating point values to
+     * IEEE-754 if needed. The view does not own the underlying bytes, which 
+     * must outlive it: scanning a file through views does not require any 
+     * allocation per trace.
+     */
+    class TraceView {
+    public:
+        
+        TraceView() : m_samples(nullptr), m_nsamples(0), m_format(0) {
+        }
+        
+        /**
+         * @brief Constructs a view over a trace stored in big-endian byte order
+         * 
+         * @param[in] data pointer to the first byte of the trace header
+         * @param[in] nsamples number of samples in the trace
+         * @param[in] format data sample format code
+         */
+        TraceView(const char * data, const size_t nsamples, const int16_t format) 
+        : m_header(data), m_samples(data + TraceHeader::buffer_size), m_nsamples(nsamples), m_format(format) {
+        }
+        
+        /**
+         * @brief Returns a view over the trace header
+         * 
+         * @return trace header view
+         */
+        const TraceHeaderView& header() const {
+            return m_header;
+        }
+        
+        /**
+         * @brief Returns the value of a trace header field in native byte order
+         * 
+         * @tparam T subscript type
+         * 
+         * @param[in] id value associated with the requested field
+         * @return value of the requested field
+         */
+        template<class T>
+        typename T::type operator[](T const id) const {
+            return m_header[id];
+        }
+        
+        /**
+         * @brief Returns the number of samples in the trace
+         * 
+         * @return number of samples
+         */
+        size_t size() const {
+            return m_nsamples;
+        }
+        
+        /**
+         * @brief Returns the data sample format code of the trace
+         * 
+         * @return format code
+         * 
+         * @see constants::SegyFileFormatCode
+         */
+        int16_t format() const {
+            return m_format;
+        }
+        
+        /**
+         * @brief Returns a raw pointer to the sample bytes (big-endian byte order)
+         * 
+         * @return pointer to the first sample
+         */
+        const char * data() const {
+            return m_samples;
+        }
+        
+        /**
+         * @brief Decodes a single sample
+         * 
+         * No check is performed on the consistency of T with the format code
+         * 
+         * @tparam T type of the sample
+         * 
+         * @param[in] ii index of the sample
+         * @return decoded sample
+         */
+        template<class T>
+        T sample(const size_t ii) const {
+            T value = readBigEndian<T>(m_samples + ii * sizeof(T));
+            if (m_format == constants::SegyFileFormatCode::IBMfloat32) {
+                convertFromIbm(value);
+            }
+            return value;
+        }
+        
+        /**
+         * @brief Decodes all the samples into a contiguous buffer
+         * 
+         * @tparam T type of the samples
+         * 
+         * @param[out] destination buffer that can hold at least size() values
+         */
+        template<class T>
+        void copyTo(T * destination) const {
+            if (constants::sizeOfDataSample(m_format) != sizeof (T)) {
+                std::stringstream estream;
+                estream << "Data format error : can't decode samples of size " << constants::sizeOfDataSample(m_format);
+                estream << " as " << typeid (T).name() << std::endl;
+                throw std::runtime_error(estream.str());
+            }
+            char * bytes = reinterpret_cast<char *>(destination);
+            if (std::is_same<T, float>::value && m_format == constants::SegyFileFormatCode::IBMfloat32) {
+                // Byte swap and conversion in a single pass
+                ibm2ieee(m_samples, bytes, m_nsamples, littleEndianHost);
+                return;
+            }
+#ifdef LITTLE_ENDIAN
+            swapByteOrder(m_samples, bytes, m_nsamples, sizeof (T));
+#else
+            std::memcpy(bytes, m_samples, m_nsamples * sizeof (T));
+#endif
+        }
+        
+    private:
+        
+        static void convertFromIbm(float& value) {
+            int32_t bits;
+            std::memcpy(&bits, &value, sizeof (bits));
+            ibm2ieee(bits);
+            std::memcpy(&value, &bits, sizeof (bits));
+        }
+        
+        template<class T>
+        static void convertFromIbm(T&) {
+        }
+        
+        TraceHeaderView m_header;
+        const char * m_samples;
+        size_t m_nsamples;
+        int16_t m_format;
+    };
+        
+}
+
+#endif	/* SEGYFILE_TRACEVIEW_H */
@@ -0,0 +1,200 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SegyFileBackend.h
+ * 
+ * @brief Interface to the low-level access of the bytes stored in a SEG Y file
+ */
+#ifndef SEGYFILEBACKEND_H
+#define	SEGYFILEBACKEND_H
+
+#include<impl/ObjectFactory-inl.h>
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/SegyFile-Trace.h>
+
+#include<boost/filesystem/fstream.hpp>
+
+#include<exception>
+#include<functional>
+#include<string>
+
+namespace seismic {
+    
+    class SegyFile;
+    
+    /**
+     * @brief Interface to a generic read backend
+     * 
+     * The concept behind the interface
+     * -----
+     * 
+     * Every read of a trace boils down to fetching a range of bytes at a 
+     * known absolute position in the SEG-Y file (the position being provided 
+     * by a SegyFileIndexer).
+     * 
+     * It is left to implementation to decide how the bytes are fetched:
+     *   - "Stream" seeks and reads the file stream owned by SegyFile (default)
+     *   - "MemoryMapped" copies the bytes directly from a read-only mapping 
+     *     of the whole file
+     *   - "Positional" issues positional reads on a file descriptor owned by
+     *     the backend
+     *   - "Async" queues many reads at once, through io_uring where 
+     *     available or through a pool of threads issuing positional reads
+     * 
+     * Implementations whose read() may be called concurrently from several 
+     * threads must state it explicitly.
+     * 
+     * The SegyFile class is implemented in terms of this interface, and the 
+     * backend can be chosen at construction in the same way as the indexer.
+     */
+    class SegyFileBackend {
+    public:
+        /// Invoked when an asynchronous read ends, with the error that occurred (if any)
+        using completion_type = std::function< void (std::exception_ptr) >;
+        
+        /**
+         * @brief Resets the SEG-Y file to be accessed
+         * 
+         * @param[in] segyFile SEG Y file to be accessed
+         */
+        virtual void reset_segy_file(SegyFile& segyFile) = 0;
+        
+        /**
+         * @brief Copies a range of bytes from the file into a buffer
+         * 
+         * No byte swapping is performed
+         * 
+         * @param[in] position absolute position of the first byte in the file
+         * @param[out] buffer buffer that will receive the bytes
+         * @param[in] size number of bytes to be read
+         */
+        virtual void read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const = 0;
+        
+        /**
+         * @brief Returns a pointer to a range of bytes of the file, if the 
+         * backend holds them in memory
+         * 
+         * The pointer remains valid until the next call to update()
+         * 
+         * @param[in] position absolute position of the first byte in the file
+         * @param[in] size number of bytes that will be accessed
+         * 
+         * @return pointer to the first byte, nullptr if the backend can't 
+         * expose its bytes directly
+         */
+        virtual const char * data(const boost::filesystem::fstream::pos_type position, const size_t size) const = 0;
+        
+        /**
+         * @brief Starts copying a range of bytes from the file into a buffer
+         * 
+         * The buffer must stay valid until the completion is invoked. The 
+         * completion may be invoked on any thread, and must not throw.
+         * 
+         * The default implementation reads synchronously, and invokes the 
+         * completion before returning.
+         * 
+         * @param[in] position absolute position of the first byte in the file
+         * @param[out] buffer buffer that will receive the bytes
+         * @param[in] size number of bytes to be read
+         * @param[in] completion invoked once the read has ended
+         */
+        virtual void readAsync(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size, const completion_type& completion) const {
+            std::exception_ptr error;
+            try {
+                read(position, buffer, size);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            completion(error);
+        }
+        
+        /**
+         * @brief Notifies the backend that the file has been modified on disk
+         * 
+         * Must be called after data appended to the file has been flushed
+         */
+        virtual void update() = 0;
+        
+        /**
+         * @brief The infamous virtual destructor
+         */
+        virtual ~SegyFileBackend() {
+        }
+        
+        INTERFACE_USE_FACTORY(SegyFileBackend,std::string)
+    };
+    
+    /**
+     * @brief Read a byte stream from a backend
+     * 
+     * @param[in] backend backend of a SEG Y file
+     * @param[in] position absolute position of the byte stream in the file
+     * @param[in,out] byteStream byte stream
+     */
+    template<int size>
+    inline void read(const SegyFileBackend& backend, const boost::filesystem::fstream::pos_type position, GenericByteStreamSmartReference<size> byteStream) {
+        backend.read(position, byteStream.get(), GenericByteStream<size>::buffer_size);
+#ifdef LITTLE_ENDIAN
+        // If the system is little endian, bytes must be swapped            
+        byteStream.invertByteOrder();
+#endif  
+    }
+    
+    /**
+     * @brief Read trace data from a backend
+     * 
+     * @param[in] backend backend of a SEG Y file
+     * @param[in] position absolute position of the first sample in the file
+     * @param[in,out] td trace data
+     * @param[in] nSamples number of samples to be read
+     * @param[in] sizeOfDataSample size of a single sample in bytes
+     */
+    inline void read(const SegyFileBackend& backend, const boost::filesystem::fstream::pos_type position, trace_data_type& td, size_t nSamples, size_t sizeOfDataSample) {
+        td.resize(nSamples * sizeOfDataSample);
+        backend.read(position, td.data(), nSamples * sizeOfDataSample);
+#ifdef LITTLE_ENDIAN
+        // If the system is little endian, bytes must be swapped
+        swapByteOrder(td.data(), nSamples, sizeOfDataSample);
+#endif  
+    }
+    
+    /**
+     * @brief Read trace data from a backend
+     * 
+     * The number of samples read is the current size of the trace
+     * 
+     * @param[in] backend backend of a SEG Y file
+     * @param[in] position absolute position of the first sample in the file
+     * @param[in,out] trace trace whose data will be read
+     */
+    template<class T>
+    void read(const SegyFileBackend& backend, const boost::filesystem::fstream::pos_type position, Trace<T>& trace) {
+        backend.read(position, reinterpret_cast<char*>(trace.data()), trace.size() * sizeof(typename Trace<T>::value_type));
+#ifdef LITTLE_ENDIAN
+        // If the system is little endian, bytes must be swapped
+        swapByteOrder(reinterpret_cast<char*>(trace.data()), trace.size(), sizeof(typename Trace<T>::value_type));
+#endif  
+    }
+        
+}
+
+#endif	/* SEGYFILEBACKEND_H */
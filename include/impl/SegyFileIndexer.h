@@ -28,14 +28,18 @@
 #define	SEGYFILEINDEXER_H
 
 #include<impl/ObjectFactory-inl.h>
+#include<impl/indexer/IndexItem-inl.h>
 
 #include<boost/filesystem/fstream.hpp>
 
+#include<memory>
 #include<string>
+#include<vector>
 
 namespace seismic {
     
     class SegyFile;
+    class HeaderIndex;
     
     /**
      * @brief Interface to a generic indexer
@@ -106,6 +110,44 @@ namespace seismic {
          */
         virtual void update_index() = 0;
         
+        /**
+         * @brief Updates the index with the traces just appended by a writer
+         * 
+         * The writer already knows where each trace starts and how many 
+         * samples it holds, so the index may be extended without reading 
+         * back the headers. Entries describe, in file order, every trace 
+         * appended since the last update.
+         * 
+         * Secondary indexes are not fed: SegyFile catches them up.
+         * 
+         * The default implementation ignores the entries and calls 
+         * update_index().
+         * 
+         * @param[in] entries appended traces
+         */
+        virtual void append_entries(const std::vector<IndexItem>& /* entries */) {
+            update_index();
+        }
+        
+        /**
+         * @brief Attaches a secondary index, that will receive the header of 
+         * each trace scanned from now on
+         * 
+         * @param[in] index secondary index
+         */
+        void attach_header_index(const std::shared_ptr<HeaderIndex>& index) {
+            m_header_indexes.push_back(index);
+        }
+        
+        /**
+         * @brief Returns the attached secondary indexes
+         * 
+         * @return attached secondary indexes
+         */
+        const std::vector< std::shared_ptr<HeaderIndex> >& header_indexes() const {
+            return m_header_indexes;
+        }
+        
         /**
          * @brief The infamous virtual destructor
          */
@@ -113,6 +155,9 @@ namespace seismic {
         }
         
         INTERFACE_USE_FACTORY(SegyFileIndexer,std::string)
+        
+    private:
+        std::vector< std::shared_ptr<HeaderIndex> > m_header_indexes;
     };
         
 }
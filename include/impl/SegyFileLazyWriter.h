@@ -27,11 +27,17 @@
 #define	SEGYFILELAZYWRITER_H
 
 #include<SegyFile.h>
+#include<impl/indexer/IndexItem-inl.h>
 
 #include<boost/filesystem/fstream.hpp>
 
+#include<array>
+#include<condition_variable>
+#include<exception>
 #include<map>
+#include<mutex>
 #include<sstream>
+#include<thread>
 #include<vector>
 
 #include "rev0/SegyFile-Fields-Rev0.h"
@@ -43,7 +49,14 @@ namespace seismic {
     /**
      * @brief Manages lazy writing of traces to a SEG Y file
      * 
-     * @todo Write a broader documentation
+     * Overwritten traces are kept in memory until the next commit. Appended 
+     * traces are encoded in an append queue, which by default also grows 
+     * until the next commit. If a memory budget is set, the queue is instead
+     * written to the end of the file in chunks of about half the budget, by 
+     * a background thread with its own file stream, while the next chunk is 
+     * being encoded. The chunk being encoded and the chunk being written 
+     * each hold at most half the budget plus one trace. Traces flushed this 
+     * way become visible (i.e. indexed) only at the next commit.
      */
     class SegyFileLazyWriter {
     public:
@@ -52,16 +65,70 @@ namespace seismic {
          * @brief Constructor from an indexer
          * 
          * @param[in] indexer indexer of a SEG Y file
+         * @param[in] fileStream stream of the SEG Y file
+         * @param[in] filePath path of the SEG Y file
+         * @param[in] permutation byte order permutation of the trace headers
          */
-        explicit SegyFileLazyWriter(SegyFileIndexer& indexer, boost::filesystem::fstream& fileStream);
+        SegyFileLazyWriter(SegyFileIndexer& indexer, boost::filesystem::fstream& fileStream, const boost::filesystem::path& filePath, 
+                           const ByteOrderPermutation<TraceHeader::buffer_size>& permutation);
+        
+        SegyFileLazyWriter(const SegyFileLazyWriter&) = delete;
+        SegyFileLazyWriter& operator=(const SegyFileLazyWriter&) = delete;
+        
+        /**
+         * @brief Stops the background flushes (appended traces that have not 
+         * been committed are lost)
+         */
+        ~SegyFileLazyWriter();
+        
+        /**
+         * @brief Bounds the memory used by the append queue
+         * 
+         * Both chunks are allocated upfront, with room for half the budget 
+         * plus the largest possible trace. The bound holds for the traces 
+         * queued after the call.
+         * 
+         * @param[in] bytes memory budget in bytes (0 means no bound)
+         */
+        void setMemoryBudget(size_t bytes);
         
         /**
          * @brief Add a trace to the overwrite queue
          * 
+         * The trace is encoded when it is queued, so it may be modified or
+         * reused right after the call.
+         * 
          * @param[in] trace trace to be written
          * @param[in] n id of the trace
+         * @param[in] sizeOfDataSample size of a data sample in bytes
+         */
+        void addToOverwriteQueue(const SegyFile::raw_trace_type& trace, size_t n, size_t sizeOfDataSample);
+        
+        /**
+         * @brief Add a trace header to the overwrite queue
+         * 
+         * Only the header bytes are written at commit. If the whole trace is 
+         * queued as well, the header replaces the one of the queued trace. 
+         * As for traces, the header is encoded when it is queued.
+         * 
+         * @param[in] header trace header to be written
+         * @param[in] n id of the trace
          */
-        void addToOverwriteQueue(const SegyFile::raw_trace_type& trace, size_t n);
+        void addToHeaderOverwriteQueue(const TraceHeader::smart_reference_type& header, size_t n);
+        
+        /**
+         * @brief Returns the queued header of a trace, to be modified in place
+         * 
+         * If the whole trace is queued, its header is returned. Otherwise, 
+         * if its header is not queued yet, a copy of the current header is 
+         * queued first.
+         * 
+         * @param[in] n id of the trace
+         * @param[in] header current header of the trace, in big-endian byte order
+         * 
+         * @return header written at commit, in big-endian byte order
+         */
+        char * headerOverwriteSlot(size_t n, const char * header);
         
         /**
          * @brief Add a trace to the append queue
@@ -70,17 +137,72 @@ namespace seismic {
          */
         void addToAppendQueue(const SegyFile::raw_trace_type& trace, size_t sizeOfDataSample);
         
+        /**
+         * @brief Reserves room for a trace at the end of the append queue
+         * 
+         * The trace header is encoded in place, in big-endian byte order. 
+         * The caller is expected to encode the trace data in the room that 
+         * follows it, which is valid until the next call to a non-const 
+         * method. Together with the reuse of the queue capacity across 
+         * commits, this lets traces be appended without allocations.
+         * 
+         * @param[in] header trace header
+         * @param[in] size size of trace data in bytes
+         * @param[in] sizeOfDataSample size of a data sample in bytes
+         * 
+         * @return pointer to the room reserved for trace data
+         */
+        char * appendSlot(TraceHeader::smart_reference_type header, size_t size, size_t sizeOfDataSample);
+        
         /**
          * @brief Commit changes to file and update index
          */
         void commit(size_t sizeOfDataSample);
     
     private:
+        /// Hands the full part of the append queue to the background thread
+        void flushAppendQueue();
+        
+        /// Waits for the background thread to be idle, and reports its errors
+        void waitForFlush(std::unique_lock<std::mutex>& lock);
+        
+        /// Body of the background thread
+        void flushLoop();
+        
+        /// Copies a trace header in big-endian byte order
+        void encodeHeader(const TraceHeader::smart_reference_type& header, char * destination) const;
+        
         SegyFileIndexer& indexer_;
         boost::filesystem::fstream& fileStream_;
+        boost::filesystem::path filePath_;
+        const ByteOrderPermutation<TraceHeader::buffer_size>& permutation_;
         
-        std::map<size_t, SegyFile::raw_trace_type> overwriteMap_;
+        /// Overwritten traces, encoded in big-endian byte order
+        std::map<size_t, std::vector<char> > overwriteMap_;
+        /// Overwritten trace headers, encoded in big-endian byte order
+        std::map<size_t, std::array<char, TraceHeader::buffer_size> > headerOverwriteMap_;
+        /// Encoded runs of overwritten traces (reused across commits)
+        std::vector<char> overwriteVector_;
         std::vector<char> appendVector_;
+        //////////
+        // Background flushes
+        //////////
+        size_t memoryBudget_;
+        /// Position of the first byte appended since the last commit, if some bytes were flushed
+        boost::filesystem::fstream::pos_type appendBase_;
+        /// Number of bytes flushed since the last commit
+        size_t flushed_;
+        /// Traces appended since the last commit, with positions relative to the first of them
+        std::vector<IndexItem> appendEntries_;
+        boost::filesystem::fstream flushStream_;
+        std::vector<char> flushVector_;
+        boost::filesystem::fstream::pos_type flushPosition_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool flushing_;
+        bool stop_;
+        std::exception_ptr error_;
+        std::thread flusher_;
     };
     
 }
@@ -0,0 +1,262 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SegyStreamReader.h
+ * @brief Sequential reader for SEG Y files, with read-ahead on a background thread
+ */
+#ifndef SEGYSTREAMREADER_H
+#define	SEGYSTREAMREADER_H
+
+#include<SegyFile.h>
+
+#include<boost/filesystem/fstream.hpp>
+
+#include<condition_variable>
+#include<deque>
+#include<exception>
+#include<iterator>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+namespace seismic {
+    
+    template<class T>
+    class SegyStreamRange;
+    
+    /**
+     * @brief Reads the traces of a SEG Y file front to back
+     * 
+     * The traces are grouped in extents of contiguous traces, each of them 
+     * fetched with a single large read. A background thread fills one buffer 
+     * while the other is being decoded, so that the latency of the storage is
+     * hidden behind the work done on the traces.
+     * 
+     * The extents are planned at construction: traces appended afterwards 
+     * are not read, and modifications must be committed beforehand. The 
+     * SEG Y file must outlive the reader, and must not be used concurrently 
+     * with it.
+     * 
+     * Example:
+     * @code
+     * SegyStreamReader reader(segyFile);
+     * for (const auto& trace : reader.tracesAs<float>()) {
+     *     // ...
+     * }
+     * @endcode
+     */
+    class SegyStreamReader {
+    public:
+        /// Default size of a read-ahead buffer, in bytes
+        static constexpr size_t default_buffer_size = 4 << 20;
+        
+        /**
+         * @brief Constructor
+         * 
+         * @param[in] segyFile SEG Y file to be read
+         * @param[in] first index of the first trace to be read
+         * @param[in] bufferSize size of a read-ahead buffer in bytes (a 
+         * buffer always holds at least one trace)
+         */
+        explicit SegyStreamReader(SegyFile& segyFile, const size_t first = 0, const size_t bufferSize = default_buffer_size);
+        
+        SegyStreamReader(const SegyStreamReader&) = delete;
+        SegyStreamReader& operator=(const SegyStreamReader&) = delete;
+        
+        /**
+         * @brief Stops the background thread
+         */
+        ~SegyStreamReader();
+        
+        /**
+         * @brief Reads the next trace into an existing trace
+         * 
+         * The trace header object and the capacity of the trace are reused, 
+         * as in SegyFile::readTraceInto. A trace without header receives a 
+         * new one.
+         * 
+         * @param[in,out] trace seismic trace (header + data)
+         * 
+         * @return true if a trace was read, false at the end of the file
+         */
+        template<class T>
+        bool next(Trace<T>& trace);
+        
+        /**
+         * @brief Returns the index of the next trace to be read
+         * 
+         * @return index of the next trace
+         */
+        size_t position() const;
+        
+        /**
+         * @brief Returns a range that yields the remaining traces
+         * 
+         * @return input range over the remaining traces
+         */
+        template<class T>
+        SegyStreamRange<T> tracesAs() {
+            return SegyStreamRange<T>(*this);
+        }
+        
+        /**
+         * @brief Creates a trace with a header of the right revision
+         * 
+         * @return an empty trace
+         */
+        template<class T>
+        Trace<T> makeTrace() const {
+            return Trace<T>(TraceHeader::smart_reference_type(segyFile_.thPrototype_->create()));
+        }
+        
+    private:
+        /// Range of contiguous traces fetched with a single read
+        struct Extent {
+            size_t first;
+            size_t count;
+            boost::filesystem::fstream::pos_type begin;
+            size_t size;
+        };
+        
+        /// Buffer that holds the bytes of an extent
+        struct Chunk {
+            size_t extent;
+            std::vector<char> bytes;
+        };
+        
+        /// Body of the background thread
+        void prefetch();
+        
+        /// Hands back the chunk being decoded, and waits for the next one
+        bool fetch();
+        
+        SegyFile& segyFile_;
+        size_t sizeOfDataSample_;
+        std::vector<Extent> extents_;
+        boost::filesystem::ifstream stream_;
+        //////////
+        // State of the consumer
+        //////////
+        Chunk current_;
+        bool holding_;
+        size_t next_;
+        size_t offset_;
+        size_t position_;
+        //////////
+        // State shared with the background thread
+        //////////
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<Chunk> ready_;
+        std::vector<Chunk> spare_;
+        bool done_;
+        bool stop_;
+        std::exception_ptr error_;
+        std::thread producer_;
+    };
+    
+    /**
+     * @brief Input iterator over the traces yielded by a SegyStreamReader
+     * 
+     * The trace pointed to is owned by the range, and is overwritten at each
+     * increment
+     */
+    template<class T>
+    class SegyStreamIterator : public std::iterator<std::input_iterator_tag, Trace<T> > {
+    public:
+        
+        /**
+         * @brief Constructs the end iterator
+         */
+        SegyStreamIterator() : reader_(nullptr), trace_(nullptr) {}
+        
+        /**
+         * @brief Constructs an iterator that points to the next trace of a reader
+         * 
+         * @param[in] reader stream reader
+         * @param[in] trace trace that receives the data
+         */
+        SegyStreamIterator(SegyStreamReader& reader, Trace<T>& trace) : reader_(&reader), trace_(&trace) {
+            ++(*this);
+        }
+        
+        const Trace<T>& operator*() const {
+            return *trace_;
+        }
+        
+        const Trace<T>* operator->() const {
+            return trace_;
+        }
+        
+        SegyStreamIterator& operator++() {
+            if (!reader_->next(*trace_)) {
+                reader_ = nullptr;
+            }
+            return *this;
+        }
+        
+        bool operator==(const SegyStreamIterator& other) const {
+            return reader_ == other.reader_;
+        }
+        
+        bool operator!=(const SegyStreamIterator& other) const {
+            return reader_ != other.reader_;
+        }
+        
+    private:
+        SegyStreamReader* reader_;
+        Trace<T>* trace_;
+    };
+    
+    /**
+     * @brief Input range over the traces yielded by a SegyStreamReader
+     * 
+     * The range owns the single trace that is reused for every step of the 
+     * iteration
+     */
+    template<class T>
+    class SegyStreamRange {
+    public:
+        
+        /**
+         * @brief Constructor
+         * 
+         * @param[in] reader stream reader
+         */
+        explicit SegyStreamRange(SegyStreamReader& reader) : reader_(reader), trace_(reader.makeTrace<T>()) {}
+        
+        SegyStreamIterator<T> begin() {
+            return SegyStreamIterator<T>(reader_, trace_);
+        }
+        
+        SegyStreamIterator<T> end() {
+            return SegyStreamIterator<T>();
+        }
+        
+    private:
+        SegyStreamReader& reader_;
+        Trace<T> trace_;
+    };
+    
+}
+
+#endif	/* SEGYSTREAMREADER_H */
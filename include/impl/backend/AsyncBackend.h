@@ -0,0 +1,94 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AsyncBackend.h
+ * @brief Backend that keeps many reads of a SEG Y file in flight
+ */
+#ifndef ASYNCBACKEND_H_20141110
+#define	ASYNCBACKEND_H_20141110
+
+#include<impl/SegyFileBackend.h>
+
+#include<boost/filesystem.hpp>
+
+#include<memory>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the SegyFileBackend interface that queues 
+     * asynchronous reads
+     * 
+     * Reads started with readAsync() are submitted through io_uring when the 
+     * library is built with it (ENABLE_IO_URING) and the kernel allows it. 
+     * Otherwise they are served by a pool of threads issuing positional 
+     * reads. Completions are invoked on a thread owned by the backend.
+     * 
+     * Synchronous reads are positional reads, as in PositionalBackend. Both 
+     * kinds of reads may be issued concurrently from several threads. The 
+     * destructor waits for the reads in flight.
+     */
+    class AsyncBackend : public SegyFileBackend {
+    public:
+        FACTORY_ADD_CREATE(AsyncBackend)
+        
+        /// Serves the reads in flight
+        class Engine;
+        
+        AsyncBackend();
+        
+        AsyncBackend(const AsyncBackend&) = delete;
+        
+        AsyncBackend& operator=(const AsyncBackend&) = delete;
+        
+        void reset_segy_file(SegyFile& segyFile) override;
+        
+        void read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const override;
+        
+        const char * data(const boost::filesystem::fstream::pos_type position, const size_t size) const override;
+        
+        void readAsync(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size, const completion_type& completion) const override;
+        
+        void update() override;
+        
+        /**
+         * @brief Checks if asynchronous reads are submitted through io_uring
+         * 
+         * @return true if io_uring is used, false if a pool of threads is used
+         */
+        bool usesIoUring() const;
+        
+        ~AsyncBackend();
+        
+    private:
+        void close();
+        
+        boost::filesystem::path m_path;
+        int m_fd;
+        std::unique_ptr<Engine> m_engine;
+        
+        static bool m_is_registered;
+    };
+    
+}
+
+#endif	/* ASYNCBACKEND_H_20141110 */
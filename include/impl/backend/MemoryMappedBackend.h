@@ -0,0 +1,73 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file MemoryMappedBackend.h
+ * @brief Backend that serves bytes from a read-only mapping of a SEG Y file
+ */
+#ifndef MEMORYMAPPEDBACKEND_H_20141012
+#define	MEMORYMAPPEDBACKEND_H_20141012
+
+#include<impl/SegyFileBackend.h>
+
+#include<boost/filesystem.hpp>
+#include<boost/interprocess/file_mapping.hpp>
+#include<boost/interprocess/mapped_region.hpp>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the SegyFileBackend interface that maps the 
+     * whole SEG Y file in memory
+     * 
+     * Trace headers and sample bytes are copied directly from the mapping 
+     * into the destination buffer: no seek is performed and no intermediate
+     * buffer is involved. Reads do not modify the state of the backend and 
+     * may be issued concurrently.
+     * 
+     * The whole file must fit the address space of the process, so this
+     * backend is of little use for very large files on 32-bit platforms.
+     */
+    class MemoryMappedBackend : public SegyFileBackend {
+    public:
+        FACTORY_ADD_CREATE(MemoryMappedBackend)
+        
+        void reset_segy_file(SegyFile& segyFile) override;
+        
+        void read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const override;
+        
+        const char * data(const boost::filesystem::fstream::pos_type position, const size_t size) const override;
+        
+        void update() override;
+        
+    private:
+        void checkRangeOrThrow(const size_t offset, const size_t size) const;
+        
+        boost::filesystem::path m_path;
+        boost::interprocess::file_mapping m_mapping;
+        boost::interprocess::mapped_region m_region;
+        
+        static bool m_is_registered;
+    };
+    
+}
+
+#endif	/* MEMORYMAPPEDBACKEND_H_20141012 */
@@ -0,0 +1,74 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file PositionalBackend.h
+ * @brief Backend that reads a SEG Y file with positional reads
+ */
+#ifndef POSITIONALBACKEND_H_20141012
+#define	POSITIONALBACKEND_H_20141012
+
+#include<impl/SegyFileBackend.h>
+
+#include<boost/filesystem.hpp>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the SegyFileBackend interface based on 
+     * positional reads (POSIX pread)
+     * 
+     * The backend owns a read-only file descriptor, independent of the file 
+     * stream of SegyFile. As positional reads do not modify any shared file
+     * offset, several threads may read traces concurrently without locks.
+     */
+    class PositionalBackend : public SegyFileBackend {
+    public:
+        FACTORY_ADD_CREATE(PositionalBackend)
+        
+        PositionalBackend();
+        
+        PositionalBackend(const PositionalBackend&) = delete;
+        
+        PositionalBackend& operator=(const PositionalBackend&) = delete;
+        
+        void reset_segy_file(SegyFile& segyFile) override;
+        
+        void read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const override;
+        
+        const char * data(const boost::filesystem::fstream::pos_type position, const size_t size) const override;
+        
+        void update() override;
+        
+        ~PositionalBackend();
+        
+    private:
+        void close();
+        
+        boost::filesystem::path m_path;
+        int m_fd;
+        
+        static bool m_is_registered;
+    };
+    
+}
+
+#endif	/* POSITIONALBACKEND_H_20141012 */
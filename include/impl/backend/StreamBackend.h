@@ -0,0 +1,73 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file StreamBackend.h
+ * @brief Backend that reads through the file stream of a SEG Y file
+ */
+#ifndef STREAMBACKEND_H_20141012
+#define	STREAMBACKEND_H_20141012
+
+#include<impl/SegyFileBackend.h>
+
+#include<SegyFile.h>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the SegyFileBackend interface that seeks and
+     * reads the file stream owned by SegyFile
+     * 
+     * This is the default backend. As the stream is shared with the indexer 
+     * and the lazy writer, reads through this backend are not thread-safe.
+     */
+    class StreamBackend : public SegyFileBackend {
+    public:
+        FACTORY_ADD_CREATE(StreamBackend)
+        
+        StreamBackend() : m_segy_file(nullptr) {
+        }
+        
+        void reset_segy_file(SegyFile& segyFile) override {
+            m_segy_file = &segyFile;
+        }
+        
+        void read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const override {
+            m_segy_file->fstream().seekg(position);
+            m_segy_file->fstream().read(buffer, size);
+        }
+        
+        const char * data(const boost::filesystem::fstream::pos_type, const size_t) const override {
+            return nullptr;
+        }
+        
+        void update() override {
+        }
+        
+    private:
+        SegyFile * m_segy_file;
+        
+        static bool m_is_registered;
+    };
+    
+}
+
+#endif	/* STREAMBACKEND_H_20141012 */
@@ -0,0 +1,119 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ComputedIndexer.h
+ * @brief Indexer that computes trace positions for files with fixed length traces
+ */
+#ifndef COMPUTEDINDEXER_H_20141019
+#define	COMPUTEDINDEXER_H_20141019
+
+#include<impl/SegyFileIndexer.h>
+
+#include<boost/filesystem/fstream.hpp>
+
+#include<memory>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the SegyFileIndexer interface for SEG-Y files
+     * whose traces all have the same number of samples
+     * 
+     * Instead of scanning every trace header, the position of a trace is 
+     * computed as:
+     * 
+     *     3600 + n * (240 + nsamples * size of a data sample)
+     * 
+     * where nsamples is read from the binary file header. Opening a file thus 
+     * takes a constant time and the index has a constant memory footprint.
+     * 
+     * Traces are assumed to have a fixed length if either:
+     *   - the file is "Rev1" and rev1::bfh::fixedLengthTraceFlag is set
+     *   - a few trace headers, sampled uniformly across the file, agree
+     *     with rev0::bfh::nsamplesDataTrace
+     * 
+     * and the size of the file is consistent with the computed trace length.
+     * Otherwise the indexer falls back to a full scan, delegating to an 
+     * "InMemory" indexer. The same happens if traces with a different number 
+     * of samples are appended later.
+     */
+    class ComputedIndexer : public SegyFileIndexer {
+    public:
+        FACTORY_ADD_CREATE(ComputedIndexer)
+        
+        ComputedIndexer();
+        
+        void reset_segy_file(SegyFile& segyFile) override;
+        
+        void create_index() override;
+        
+        void clear_index() override;
+        
+        boost::filesystem::fstream::pos_type position(const size_t n) const override;
+        
+        size_t size() const override;
+        
+        size_t nsamples(const size_t n) const override;
+        
+        void update_index() override;
+        
+        void append_entries(const std::vector<IndexItem>& entries) override;
+        
+        /**
+         * @brief Checks whether the index is computed or has fallen back to 
+         * a full scan of the file
+         * 
+         * @return true if positions are computed, false otherwise
+         */
+        bool computed() const;
+        
+    private:
+        /// Number of trace headers sampled to detect fixed length traces
+        static const size_t nprobes = 8;
+        
+        /// Returns the number of samples stored in the trace header at position
+        size_t nsamplesAt(const boost::filesystem::fstream::pos_type position) const;
+        
+        /// Returns the current size of the SEG-Y file
+        size_t fileSize() const;
+        
+        /// Computes the trace length and the number of traces from the file size
+        void computeIndex(const size_t maxChecks);
+        
+        /// Checks, sampling at most maxChecks headers, if the traces in [first, size) have a fixed length
+        bool checkFixedLength(const size_t first, const size_t size, const size_t maxChecks) const;
+        
+        /// Replaces the computed index with a full scan of the file
+        void fallBackToFullScan();
+        
+        SegyFile * m_segy_file;
+        size_t m_nsamples;
+        size_t m_trace_size;
+        size_t m_size;
+        std::shared_ptr<SegyFileIndexer> m_full_scan;
+        
+        static bool m_is_registered;
+    };
+    
+}
+
+#endif	/* COMPUTEDINDEXER_H_20141019 */
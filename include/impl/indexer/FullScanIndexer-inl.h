@@ -33,6 +33,9 @@
 #include<SegyFile.h>
 #include<impl/ObjectFactory-inl.h>
 #include<impl/SegyFile-TraceHeader.h>
+#include<impl/indexer/HeaderIndex.h>
+#include<impl/indexer/IndexSignature-inl.h>
+#include<impl/indexer/ParallelHeaderScanner.h>
 #include<impl/rev0/SegyFile-BinaryFileHeader-Rev0.h>
 
 #include<boost/filesystem.hpp>
@@ -41,6 +44,7 @@
 #include<iostream>
 #include<sstream>
 #include<stdexcept>
+#include<thread>
 
 namespace seismic {
 
@@ -62,11 +66,28 @@ namespace seismic {
         size_t size() const override;
         
         void update_index() override;
+        
+        void append_entries(const std::vector<IndexItem>& entries) override;
 
         void reset_segy_file(SegyFile& segyFile) override;
 
     private:
+        /// Minimum number of traces to be scanned by each thread
+        static const size_t min_traces_per_thread = 4096;
+        
         inline void scanFileAndUpdateIndexFromCurrentPosition();
+        
+        /// Scans as much of the file as possible in parallel, returning where the scan stopped
+        inline boost::filesystem::fstream::pos_type scanFileInParallel();
+        
+        /// Computes the signature of the SEG-Y file as covered by the current index
+        inline IndexSignature currentSignature() const;
+        
+        /// Checks if an index synchronized with a given signature can be reused
+        inline bool reusable(const IndexSignature& signature) const;
+        
+        /// Computes the checksum of the trace header at a given position
+        inline uint64_t headerChecksum(const boost::filesystem::fstream::pos_type position) const;
 
         SegyFile * m_segy_file;
         boost::filesystem::fstream::pos_type m_previous_end_of_file;
@@ -82,14 +103,23 @@ namespace seismic {
     template< class StorageType >
     void FullScanIndexer<StorageType>::reset_segy_file(SegyFile& segyFile) {
         m_segy_file = &segyFile;
+        // A persistent storage may retain the index of a previous run
         m_store.reset(m_segy_file);
-        clear_index();
+        m_previous_end_of_file = 0;
     }
     
     template< class StorageType >
     void FullScanIndexer<StorageType>::create_index() {
         /// @bug Check if a SEG-Y file is currently set
-        m_segy_file->fstream().seekg(3600,std::ios::beg);
+        auto signature = m_store.signature();
+        if ( reusable(signature) ) {
+            // Only the traces appended since the last run need to be scanned
+            m_previous_end_of_file = static_cast<std::streamoff>(signature.segy_size);
+            update_index();
+            return;
+        }
+        clear_index();
+        m_segy_file->fstream().seekg(scanFileInParallel());
         scanFileAndUpdateIndexFromCurrentPosition();
     }
 
@@ -119,10 +149,35 @@ namespace seismic {
         scanFileAndUpdateIndexFromCurrentPosition();
     }
     
+    template< class StorageType >
+    void FullScanIndexer<StorageType>::append_entries(const std::vector<IndexItem>& entries) {
+        // Seeking through the stream flushes any pending write
+        m_segy_file->fstream().seekg(0, std::ios::end);
+        boost::filesystem::fstream::pos_type end = m_segy_file->fstream().tellg();
+        // Entries must cover exactly the bytes appended since the last update
+        auto position = m_previous_end_of_file;
+        size_t sizeOfDataSample = constants::sizeOfDataSample(m_segy_file->getBinaryFileHeader()[rev0::bfh::formatCode]);
+        for (const auto& x : entries) {
+            if ( x.position() != position ) {
+                break;
+            }
+            position += TraceHeader::buffer_size + sizeOfDataSample * x.nsamples();
+        }
+        if ( position != end ) {
+            update_index();
+            return;
+        }
+        for (const auto& x : entries) {
+            m_store.push_back(x.position(), x.nsamples());
+        }
+        m_previous_end_of_file = end;
+        m_store.sync(currentSignature());
+    }
+    
     template< class StorageType >
     void FullScanIndexer<StorageType>::scanFileAndUpdateIndexFromCurrentPosition() {
         boost::filesystem::fstream::pos_type position = m_segy_file->fstream().tellg();
-        TraceHeader::smart_reference_type th(TraceHeader::create(m_segy_file->tag()));
+        char th[TraceHeader::buffer_size];
         auto segyFileSize = file_size(m_segy_file->path());
         while (true) {
             // Check for end of file
@@ -140,14 +195,16 @@ namespace seismic {
             size_t sizeOfDataSample_ = constants::sizeOfDataSample(m_segy_file->getBinaryFileHeader()[rev0::bfh::formatCode]);
             // Move to the start of the next trace header and read it
             m_segy_file->fstream().seekg(position);
-            // Read trace header
-            m_segy_file->fstream().read(th.get(), TraceHeader::buffer_size);
-#ifdef LITTLE_ENDIAN
-            // If the system is little endian, bytes must be swapped
-            th.invertByteOrder();
-#endif        
+            // Read trace header (fields are decoded directly from big-endian bytes)
+            m_segy_file->fstream().read(th, TraceHeader::buffer_size);
             // Compute the number of samples in the next trace to update the stride
-            size_t nsamples = th[rev0::th::nsamplesTrace];
+            size_t nsamples = static_cast<uint16_t>( TraceHeaderView(th)[rev0::th::nsamplesTrace] );
+            for (auto& x : header_indexes()) {
+                // Indexes lagging behind are caught up by SegyFile
+                if ( x->size() >= m_store.size() ) {
+                    x->insert(m_store.size(), th);
+                }
+            }
             m_store.push_back(position,nsamples);
             // Update the current stride in the file
             position += TraceHeader::buffer_size + sizeOfDataSample_ * nsamples;
@@ -155,6 +212,73 @@ namespace seismic {
         // Register last position in the file
         m_segy_file->fstream().seekg(0, std::ios::end);
         m_previous_end_of_file = m_segy_file->fstream().tellg();
+        m_store.sync(currentSignature());
+    }
+    
+    template< class StorageType >
+    boost::filesystem::fstream::pos_type FullScanIndexer<StorageType>::scanFileInParallel() {
+        boost::filesystem::fstream::pos_type begin(3600);
+        auto nthreads = std::thread::hardware_concurrency();
+        // The parallel scan doesn't feed secondary indexes
+        if ( nthreads < 2 || !header_indexes().empty() || file_size(m_segy_file->path()) == 3600 ) {
+            return begin;
+        }
+        ParallelHeaderScanner scanner(
+                m_segy_file->path(),
+                constants::sizeOfDataSample(m_segy_file->getBinaryFileHeader()[rev0::bfh::formatCode]),
+                nthreads,
+                min_traces_per_thread
+                );
+        return scanner.scan(begin, [this](boost::filesystem::fstream::pos_type position, size_t nsamples) {
+            m_store.push_back(position, nsamples);
+        });
+    }
+    
+    template< class StorageType >
+    IndexSignature FullScanIndexer<StorageType>::currentSignature() const {
+        IndexSignature signature;
+        signature.magic = IndexSignature::magic_number;
+        signature.version = IndexSignature::current_version;
+        signature.segy_size = static_cast<uint64_t>( static_cast<std::streamoff>(m_previous_end_of_file) );
+        signature.segy_mtime = static_cast<int64_t>( last_write_time(m_segy_file->path()) );
+        if ( m_store.size() != 0 ) {
+            signature.first_header_checksum = headerChecksum( m_store.load(0).position() );
+            signature.last_header_checksum = headerChecksum( m_store.load(m_store.size() - 1).position() );
+        }
+        return signature;
+    }
+    
+    template< class StorageType >
+    bool FullScanIndexer<StorageType>::reusable(const IndexSignature& signature) const {
+        if ( !signature.valid() ) {
+            return false;
+        }
+        auto segyFileSize = file_size(m_segy_file->path());
+        // A file of the same size must not have been modified since the last
+        // synchronization, while a larger one is assumed to have been appended to
+        if ( segyFileSize < signature.segy_size ) {
+            return false;
+        } else if ( segyFileSize == signature.segy_size && 
+                static_cast<int64_t>( last_write_time(m_segy_file->path()) ) != signature.segy_mtime ) {
+            return false;
+        }
+        if ( m_store.size() == 0 ) {
+            return signature.segy_size == 3600;
+        }
+        auto lastHeaderEnd = static_cast<std::streamoff>( m_store.load(m_store.size() - 1).position() ) + TraceHeader::buffer_size;
+        if ( static_cast<uint64_t>(lastHeaderEnd) > signature.segy_size ) {
+            return false;
+        }
+        return headerChecksum( m_store.load(0).position() ) == signature.first_header_checksum &&
+                headerChecksum( m_store.load(m_store.size() - 1).position() ) == signature.last_header_checksum;
+    }
+    
+    template< class StorageType >
+    uint64_t FullScanIndexer<StorageType>::headerChecksum(const boost::filesystem::fstream::pos_type position) const {
+        char buffer[TraceHeader::buffer_size];
+        m_segy_file->fstream().seekg(position);
+        m_segy_file->fstream().read(buffer, TraceHeader::buffer_size);
+        return IndexSignature::checksum(buffer, TraceHeader::buffer_size);
     }
         
 }
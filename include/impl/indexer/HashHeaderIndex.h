@@ -0,0 +1,68 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file HashHeaderIndex.h
+ * @brief Secondary index based on hash tables
+ */
+#ifndef HASHHEADERINDEX_H_20141024
+#define	HASHHEADERINDEX_H_20141024
+
+#include<impl/indexer/HeaderIndex.h>
+
+#include<unordered_map>
+#include<vector>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the HeaderIndex interface that keeps the trace 
+     * ids for each key in a hash table
+     * 
+     * Lookups cost O(result) on average. Keys made of two fields get a second 
+     * table, keyed by the first field only.
+     */
+    class HashHeaderIndex : public HeaderIndex {
+    public:
+        explicit HashHeaderIndex(const HeaderKey& key);
+        
+    private:
+        struct KeyHash {
+            size_t operator()(const key_type& key) const {
+                return std::hash<uint64_t>()( (static_cast<uint64_t>(static_cast<uint32_t>(key.first)) << 32) | static_cast<uint32_t>(key.second) );
+            }
+        };
+        
+        void clear_lookup() override;
+        
+        void extend_lookup(const size_t first) override;
+        
+        result_type find_key(const key_type& key) const override;
+        
+        result_type find_first(const int32_t value) const override;
+        
+        std::unordered_map<key_type, result_type, KeyHash> m_by_key;
+        std::unordered_map<int32_t, result_type> m_by_first;
+    };
+    
+}
+
+#endif	/* HASHHEADERINDEX_H_20141024 */
@@ -0,0 +1,265 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file HeaderIndex.h
+ * @brief Interface to secondary indexes, keyed by trace header fields
+ */
+#ifndef HEADERINDEX_H_20141024
+#define	HEADERINDEX_H_20141024
+
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/metafunctions-inl.h>
+
+#include<cstdint>
+#include<map>
+#include<utility>
+#include<vector>
+
+namespace seismic {
+    
+    /**
+     * @brief Key of a secondary index, made of one or two trace header fields
+     * 
+     * The value of the key for a given trace is a pair of 32 bits integers. If 
+     * the key is made of a single field, the second element of the pair is 
+     * always zero.
+     * 
+     * Example:
+     * @code
+     * HeaderKey lines(rev1::th::inlineNumber, rev1::th::crosslineNumber);
+     * HeaderKey gathers(rev0::th::ensembleNumber, rev0::th::distanceFromCenterSourceToCenterReceiver);
+     * @endcode
+     */
+    class HeaderKey {
+    public:
+        /// Value of the key
+        using value_type = std::pair<int32_t, int32_t>;
+        
+        /**
+         * @brief Key made of a single field
+         * 
+         * @param[in] first field (Int32Field or Int16Field)
+         */
+        template<class T>
+        explicit HeaderKey(const Field<T>& first) : m_first(component(first)), m_second{0, 0} {
+        }
+        
+        /**
+         * @brief Key made of two fields
+         * 
+         * @param[in] first first field (Int32Field or Int16Field)
+         * @param[in] second second field (Int32Field or Int16Field)
+         */
+        template<class T, class U>
+        HeaderKey(const Field<T>& first, const Field<U>& second) : m_first(component(first)), m_second(component(second)) {
+        }
+        
+        /**
+         * @brief Returns the number of fields in the key
+         * 
+         * @return 1 or 2
+         */
+        size_t size() const {
+            return m_second.size == 0 ? 1 : 2;
+        }
+        
+        /**
+         * @brief Computes the key of a trace header stored in big-endian byte order
+         * 
+         * @param[in] header pointer to the first byte of the trace header
+         * @return value of the key
+         */
+        value_type operator()(const char * header) const;
+        
+        /**
+         * @brief Computes the key of a trace header in native byte order
+         * 
+         * @param[in] header trace header
+         * @return value of the key
+         */
+        value_type operator()(const TraceHeader::smart_reference_type& header) const;
+        
+    private:
+        /// Offset and size (4, 2 or 0 if absent) of a field
+        struct Component {
+            long long int offset;
+            size_t size;
+        };
+        
+        template<class T>
+        static Component component(const Field<T>& field) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 2, "Only Int32Field and Int16Field can be part of a key");
+            return Component{field.value_, sizeof(T)};
+        }
+        
+        static int32_t extract(const char * header, const Component& component);
+        
+        static int32_t extract(const TraceHeader::smart_reference_type& header, const Component& component);
+        
+        Component m_first;
+        Component m_second;
+    };
+    
+    /**
+     * @brief Interface to a secondary index, mapping the value of a HeaderKey
+     * to the ids of the traces that have it
+     * 
+     * The key of every trace is recorded, in trace order, by the indexer of
+     * SegyFile during the same pass that builds the primary index (or by a 
+     * catch-up pass, for indexers that don't read trace headers). The 
+     * implementations decide how to organize keys to answer lookups:
+     *   - SortedHeaderIndex : sorted array, binary search
+     *   - HashHeaderIndex : hash tables
+     *   - RegularGridHeaderIndex : runs of traces on a regular lattice
+     * 
+     * Lookups reflect the keys recorded until the last call to update(), that
+     * SegyFile performs after each indexing pass. Lookups may be performed 
+     * concurrently, while insertions require exclusive access.
+     * 
+     * By default the recorded keys are retained, one per trace, next to the 
+     * lookup structures. Implementations that can recover keys from their 
+     * lookup structures may instead drop them at each update.
+     */
+    class HeaderIndex {
+    public:
+        /// Value of the key
+        using key_type = HeaderKey::value_type;
+        /// Ids of the traces matching a lookup, in increasing order
+        using result_type = std::vector<size_t>;
+        
+        /**
+         * @brief Constructor
+         * 
+         * @param[in] key header fields the index is keyed by
+         * @param[in] retain_keys whether the keys of traces already added to 
+         * the lookup structures are retained (if false, the implementation 
+         * must override lookup_key() and lookup_keys())
+         */
+        explicit HeaderIndex(const HeaderKey& key, const bool retain_keys = true);
+        
+        /**
+         * @brief Returns the key of the index
+         * 
+         * @return key of the index
+         */
+        const HeaderKey& key() const;
+        
+        /**
+         * @brief Returns the number of traces whose key has been recorded
+         * 
+         * @return number of traces
+         */
+        size_t size() const;
+        
+        /**
+         * @brief Records the key of trace n
+         * 
+         * Traces are recorded in order: n may either be an already recorded 
+         * trace (whose key is replaced) or size()
+         * 
+         * @param[in] n trace id
+         * @param[in] header trace header, in big-endian byte order
+         */
+        void insert(const size_t n, const char * header);
+        
+        /**
+         * @brief Records the key of trace n
+         * 
+         * @param[in] n trace id
+         * @param[in] header trace header, in native byte order
+         */
+        void insert(const size_t n, const TraceHeader::smart_reference_type& header);
+        
+        /**
+         * @brief Brings lookups up to date with the recorded keys
+         * 
+         * Traces appended since the last update are added incrementally, while
+         * a replaced key causes a rebuild.
+         */
+        void update();
+        
+        /**
+         * @brief Forgets every recorded key
+         */
+        void clear();
+        
+        /**
+         * @brief Returns the traces whose key is equal to a given value
+         * 
+         * @param[in] key value of the key
+         * @return ids of the matching traces
+         */
+        result_type find(const key_type& key) const;
+        
+        /**
+         * @brief Returns the traces whose first field is equal to a given value
+         * 
+         * @param[in] value value of the first field
+         * @return ids of the matching traces
+         */
+        result_type findFirst(const int32_t value) const;
+        
+        /**
+         * @brief The infamous virtual destructor
+         */
+        virtual ~HeaderIndex();
+        
+    protected:
+        /// Recorded key of trace n, available for traces not yet added to the lookup structures (or for every trace, if keys are retained)
+        const key_type& recorded_key(const size_t n) const;
+        
+    private:
+        void record(const size_t n, const key_type& key);
+        
+        /// Drops every lookup structure
+        virtual void clear_lookup() = 0;
+        
+        /// Adds the keys of traces [first, size()) to the lookup structures
+        virtual void extend_lookup(const size_t first) = 0;
+        
+        /// Recovers the key of trace n from the lookup structures (needed if keys are not retained)
+        virtual key_type lookup_key(const size_t n) const;
+        
+        /// Appends the keys of every trace in the lookup structures, in trace order (needed if keys are not retained)
+        virtual void lookup_keys(std::vector<key_type>& keys) const;
+        
+        virtual result_type find_key(const key_type& key) const = 0;
+        
+        virtual result_type find_first(const int32_t value) const = 0;
+        
+        HeaderKey m_key;
+        bool m_retain_keys;
+        /// Recorded keys of traces [m_offset, size())
+        std::vector<key_type> m_keys;
+        /// Id of the first trace in m_keys (always 0 if keys are retained)
+        size_t m_offset;
+        /// Replaced keys of traces below m_offset
+        std::map<size_t, key_type> m_replacements;
+        /// Number of keys already added to the lookup structures
+        size_t m_nupdated;
+        /// Whether a key already added to the lookup structures has been replaced
+        bool m_replaced;
+    };
+    
+}
+
+#endif	/* HEADERINDEX_H_20141024 */
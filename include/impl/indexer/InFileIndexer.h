@@ -30,11 +30,19 @@
 #include<impl/indexer/FullScanIndexer-inl.h>
 
 #include<impl/indexer/IndexItem-inl.h>
+#include<impl/indexer/IndexSignature-inl.h>
 
 #include<boost/filesystem/fstream.hpp>
 
 namespace seismic {
 
+    /**
+     * @brief Storage that keeps the index in a file next to the SEG-Y file
+     * 
+     * The index file starts with an IndexSignature, followed by the index 
+     * items. The file is kept across runs, so that an index still matching 
+     * the SEG-Y file needs not be rebuilt.
+     */
     class InFileStorage {
     public:
 
@@ -52,16 +60,22 @@ namespace seismic {
         
         IndexItem load(size_t n) const {
             IndexItem item;
-            m_stream.seekg( n * sizeof(IndexItem), std::ios::beg );
+            m_stream.seekg( sizeof(IndexSignature) + n * sizeof(IndexItem), std::ios::beg );
             m_stream.read(reinterpret_cast<char*>(&item),sizeof(IndexItem));
             return item;
         }
         
         void reset(SegyFile * file) {            
-            /// @todo check if this is the right open mode
             m_index_filename = file->path();
             m_index_filename.replace_extension("index");
-            clear();
+            m_stream.close();
+            // Reuse a previous index, if any
+            if ( exists(m_index_filename) && file_size(m_index_filename) >= sizeof(IndexSignature) ) {
+                m_stream.open(m_index_filename,std::ios::binary|std::ios::in|std::ios::out);
+                m_size = ( file_size(m_index_filename) - sizeof(IndexSignature) ) / sizeof(IndexItem);
+            } else {
+                clear();
+            }
         }
         
         void clear() {
@@ -70,11 +84,26 @@ namespace seismic {
               // while just closing, removing and reopening does not
               remove(m_index_filename);
               boost::filesystem::fstream tmp(m_index_filename, std::ios::binary | std::ios::out);
+              IndexSignature invalid;
+              tmp.write(reinterpret_cast<const char*>(&invalid),sizeof(IndexSignature));
             }
             m_stream.open(m_index_filename,std::ios::binary|std::ios::in|std::ios::out);
             m_size = 0;
         }
         
+        IndexSignature signature() const {
+            IndexSignature signature;
+            m_stream.seekg(0, std::ios::beg);
+            m_stream.read(reinterpret_cast<char*>(&signature),sizeof(IndexSignature));
+            return signature;
+        }
+        
+        void sync(const IndexSignature& signature) {
+            m_stream.seekp(0, std::ios::beg);
+            m_stream.write(reinterpret_cast<const char*>(&signature),sizeof(IndexSignature));
+            m_stream.flush();
+        }
+        
     private:
         boost::filesystem::path m_index_filename;
         size_t m_size{0};
@@ -28,6 +28,7 @@
 
 #include<impl/indexer/FullScanIndexer-inl.h>
 #include<impl/indexer/IndexItem-inl.h>
+#include<impl/indexer/IndexSignature-inl.h>
 #include<impl/SegyFileIndexer.h>
 
 #include<boost/filesystem/fstream.hpp>
@@ -61,6 +62,14 @@ namespace seismic {
           m_index.clear();
         }
         
+        IndexSignature signature() const {
+            // Nothing survives across runs
+            return IndexSignature();
+        }
+        
+        void sync(const IndexSignature&) {
+        }
+        
     private:
         std::vector<IndexItem> m_index;
     };
@@ -29,13 +29,20 @@
 #include<boost/filesystem.hpp>
 #include<boost/filesystem/fstream.hpp>
 
-#include<utility>
+#include<cstdint>
+#include<sstream>
+#include<stdexcept>
 
 namespace seismic {
     
     /**
      * @brief Defines the information needed to index a trace in a SEG-Y file
      * for a later random access
+     * 
+     * The item is packed in 8 bytes: 48 bits for the position of the trace 
+     * (up to 256 TiB) and 16 bits for the number of samples (the size of the 
+     * "Number of samples" field of the trace header). The same representation
+     * is used in memory and in index files.
      */
     class IndexItem {
     public:
@@ -44,11 +51,25 @@ namespace seismic {
         /// Type that represents a position in a file
         using position_type = boost::filesystem::fstream::pos_type;
         
-        IndexItem(){}
+        /// Largest position that can be stored in an item
+        static const uint64_t max_position = (uint64_t(1) << 48) - 1;
+        /// Largest number of samples that can be stored in an item
+        static const uint64_t max_nsamples = 0xffff;
+        
+        IndexItem() : value_(0) {}
         
         template<class T, class U>
         IndexItem(T&& position, U&& nsamples) {
-            value_ = std::make_pair(position,nsamples);
+            auto offset = static_cast<uint64_t>( static_cast<std::streamoff>(position) );
+            auto count = static_cast<uint64_t>(nsamples);
+            if ( offset > max_position || count > max_nsamples ) {
+                std::stringstream estream;
+                estream << "FATAL ERROR: can't index a trace at position " << offset << " with " << count << " samples" << std::endl;
+                estream << "\tlargest position : " << max_position << std::endl;
+                estream << "\tlargest number of samples : " << max_nsamples << std::endl;
+                throw std::out_of_range(estream.str());
+            }
+            value_ = (offset << 16) | count;
         }
         
         /**
@@ -57,7 +78,7 @@ namespace seismic {
          * @return position
          */
         position_type position() const {
-            return value_.first;
+            return position_type( static_cast<std::streamoff>(value_ >> 16) );
         }
         
         /**
@@ -66,13 +87,15 @@ namespace seismic {
          * @return number of samples
          */
         nsamples_type nsamples() const {
-            return value_.second;
+            return static_cast<nsamples_type>(value_ & max_nsamples);
         }
         
     private:
-        std::pair<position_type,nsamples_type> value_;
+        uint64_t value_;
     };
     
+    static_assert(sizeof(IndexItem) == sizeof(uint64_t), "IndexItem must be packed in 8 bytes");
+    
 }
 
 
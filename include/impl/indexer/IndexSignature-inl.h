@@ -0,0 +1,94 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file IndexSignature-inl.h
+ * @brief Defines the signature that ties a persistent index to a SEG-Y file
+ */
+#ifndef INDEXSIGNATURE_INL_H_20141020
+#define	INDEXSIGNATURE_INL_H_20141020
+
+#include<cstddef>
+#include<cstdint>
+
+namespace seismic {
+    
+    /**
+     * @brief Header of a persistent index
+     * 
+     * Records the state of the SEG-Y file at the time the index was last 
+     * synchronized: its size and modification time, and a checksum of the 
+     * first and last indexed trace headers. An index whose signature still 
+     * matches the SEG-Y file may be reused when the file is opened again.
+     */
+    struct IndexSignature {
+        /// Identifies an index file ("SGYI")
+        static const uint32_t magic_number = 0x49594753;
+        /// Version of the index format, to be bumped on any change to the layout
+        static const uint32_t current_version = 2;
+        /// Initial value of a checksum
+        static const uint64_t checksum_seed = 14695981039346656037ull;
+        
+        uint32_t magic{0};
+        uint32_t version{0};
+        /// Size of the SEG-Y file covered by the index
+        uint64_t segy_size{0};
+        /// Last modification time of the SEG-Y file
+        int64_t segy_mtime{0};
+        /// Checksum of the first indexed trace header
+        uint64_t first_header_checksum{0};
+        /// Checksum of the last indexed trace header
+        uint64_t last_header_checksum{0};
+        
+        /**
+         * @brief Checks if the signature has been written by the current 
+         * version of the library
+         * 
+         * @return true if the signature is valid, false otherwise
+         */
+        bool valid() const {
+            return magic == magic_number && version == current_version;
+        }
+        
+        /**
+         * @brief Computes the checksum of a stream of bytes (64-bit FNV-1a)
+         * 
+         * A checksum may be extended with more bytes, by passing it as the 
+         * initial value.
+         * 
+         * @param[in] data pointer to the first byte
+         * @param[in] size number of bytes
+         * @param[in] hash checksum of the preceding bytes
+         * 
+         * @return checksum
+         */
+        static uint64_t checksum(const char * data, const size_t size, uint64_t hash = checksum_seed) {
+            for (size_t ii = 0; ii < size; ++ii) {
+                hash ^= static_cast<unsigned char>(data[ii]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    };
+    
+}
+
+#endif	/* INDEXSIGNATURE_INL_H_20141020 */
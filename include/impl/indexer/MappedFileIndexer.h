@@ -0,0 +1,143 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file MappedFileIndexer.h
+ * @brief Indexer that stores information in a memory-mapped file
+ */
+#ifndef MAPPEDFILEINDEXER_H_20141021
+#define	MAPPEDFILEINDEXER_H_20141021
+
+#include<impl/indexer/FullScanIndexer-inl.h>
+
+#include<impl/indexer/IndexItem-inl.h>
+#include<impl/indexer/IndexSignature-inl.h>
+
+#include<boost/filesystem.hpp>
+#include<boost/filesystem/fstream.hpp>
+#include<boost/interprocess/file_mapping.hpp>
+#include<boost/interprocess/mapped_region.hpp>
+
+#include<vector>
+
+namespace seismic {
+
+    /**
+     * @brief Storage that keeps the index in a memory-mapped file
+     * 
+     * The index file has the same layout as the one of InFileStorage. Items 
+     * already in the file are served by plain loads from a read-only mapping,
+     * and the OS page cache keeps in memory only the parts that are actually
+     * accessed. Items pushed during a scan are staged in memory, and written 
+     * to the file (which is then mapped again) on sync.
+     */
+    class MappedFileStorage {
+    public:
+        
+        template<class T, class U>        
+        void push_back(T&& position,U&& nsamples) {
+            m_staging.emplace_back(position,nsamples);
+        }
+        
+        size_t size() const {
+            return m_mapped_size + m_staging.size();
+        }
+        
+        IndexItem load(size_t n) const {
+            if ( n < m_mapped_size ) {
+                return m_items[n];
+            }
+            /// @todo Check performance issues related to range-checked access
+            return m_staging.at(n - m_mapped_size);
+        }
+        
+        void reset(SegyFile * file) {
+            m_index_filename = file->path();
+            m_index_filename.replace_extension("index");
+            m_staging.clear();
+            // Reuse a previous index, if any
+            if ( exists(m_index_filename) && file_size(m_index_filename) >= sizeof(IndexSignature) ) {
+                map();
+            } else {
+                clear();
+            }
+        }
+        
+        void clear() {
+            unmap();
+            {
+                boost::filesystem::fstream tmp(m_index_filename, std::ios::binary | std::ios::out | std::ios::trunc);
+                IndexSignature invalid;
+                tmp.write(reinterpret_cast<const char*>(&invalid),sizeof(IndexSignature));
+            }
+            m_staging.clear();
+            map();
+        }
+        
+        IndexSignature signature() const {
+            return *static_cast<const IndexSignature*>( m_region.get_address() );
+        }
+        
+        void sync(const IndexSignature& signature) {
+            unmap();
+            {
+                boost::filesystem::fstream tmp(m_index_filename, std::ios::binary | std::ios::in | std::ios::out);
+                tmp.seekp(0, std::ios::end);
+                tmp.write(reinterpret_cast<const char*>(m_staging.data()), m_staging.size() * sizeof(IndexItem));
+                tmp.seekp(0, std::ios::beg);
+                tmp.write(reinterpret_cast<const char*>(&signature),sizeof(IndexSignature));
+            }
+            m_staging.clear();
+            map();
+        }
+        
+    private:
+        
+        void map() {
+            m_mapping = boost::interprocess::file_mapping(m_index_filename.c_str(), boost::interprocess::read_only);
+            m_region = boost::interprocess::mapped_region(m_mapping, boost::interprocess::read_only);
+            m_items = reinterpret_cast<const IndexItem*>( static_cast<const char*>(m_region.get_address()) + sizeof(IndexSignature) );
+            m_mapped_size = ( m_region.get_size() - sizeof(IndexSignature) ) / sizeof(IndexItem);
+        }
+        
+        void unmap() {
+            m_region = boost::interprocess::mapped_region();
+            m_mapping = boost::interprocess::file_mapping();
+            m_items = nullptr;
+            m_mapped_size = 0;
+        }
+        
+        boost::filesystem::path m_index_filename;
+        boost::interprocess::file_mapping m_mapping;
+        boost::interprocess::mapped_region m_region;
+        const IndexItem * m_items{nullptr};
+        size_t m_mapped_size{0};
+        std::vector<IndexItem> m_staging;
+    };
+
+    /**
+     * @brief Implementation of the SegyFileIndexer interface that maintains
+     * information in a memory-mapped file
+     */
+    using MappedFileIndexer = FullScanIndexer<MappedFileStorage>;    
+}
+
+#endif	/* MAPPEDFILEINDEXER_H_20141021 */
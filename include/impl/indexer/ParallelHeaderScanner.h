@@ -0,0 +1,94 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ParallelHeaderScanner.h
+ * @brief Multi-threaded scan of the trace headers of a SEG-Y file
+ */
+#ifndef PARALLELHEADERSCANNER_H_20141022
+#define	PARALLELHEADERSCANNER_H_20141022
+
+#include<boost/filesystem.hpp>
+#include<boost/filesystem/fstream.hpp>
+
+#include<functional>
+
+namespace seismic {
+    
+    /**
+     * @brief Scans the trace headers of a SEG-Y file with several threads
+     * 
+     * The length of the trace at the current position is used to predict 
+     * where the following traces start. The remaining part of the file is 
+     * split into chunks at the predicted trace boundaries, and each chunk is 
+     * walked header by header by a separate thread, with its own stream.
+     * 
+     * The walks are then stitched in order: the walk of a chunk is accepted 
+     * only if the walk of the previous chunk ended exactly where the chunk 
+     * was predicted to start. At the first mismatch (e.g. due to a trace of 
+     * different length) a new round of predictions starts from the last 
+     * verified position. Each round verifies at least the first chunk, so 
+     * files with a few outliers are still scanned in parallel. A walk stops 
+     * after twice the number of traces predicted for its chunk, which bounds 
+     * the memory spent on walks that started inside trace data.
+     */
+    class ParallelHeaderScanner {
+    public:
+        /// Type that represents a position in a file
+        using position_type = boost::filesystem::fstream::pos_type;
+        /// Receives the position and the number of samples of each trace, in file order
+        using sink_type = std::function<void (position_type, size_t)>;
+        
+        /**
+         * @brief Constructor
+         * 
+         * @param[in] path SEG-Y file to be scanned
+         * @param[in] sizeOfDataSample size of a data sample in bytes
+         * @param[in] nthreads maximum number of threads
+         * @param[in] minTracesPerChunk minimum number of traces to be walked by a thread
+         */
+        ParallelHeaderScanner(const boost::filesystem::path& path, const size_t sizeOfDataSample, const size_t nthreads, const size_t minTracesPerChunk);
+        
+        /**
+         * @brief Scans the traces that start at or after a given position
+         * 
+         * The scan stops early if the remaining part of the file is too small
+         * to be split among threads, or if it can't be walked (e.g. because 
+         * the file is truncated). The caller is expected to scan what is left 
+         * sequentially, which also reports errors.
+         * 
+         * @param[in] begin position of the first trace header
+         * @param[in] sink receives every trace found, in file order
+         * 
+         * @return position where the verified part of the scan ends
+         */
+        position_type scan(const position_type begin, const sink_type& sink) const;
+        
+    private:
+        boost::filesystem::path m_path;
+        size_t m_size_of_data_sample;
+        size_t m_nthreads;
+        size_t m_min_traces_per_chunk;
+    };
+    
+}
+
+#endif	/* PARALLELHEADERSCANNER_H_20141022 */
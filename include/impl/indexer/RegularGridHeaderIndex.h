@@ -0,0 +1,259 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file RegularGridHeaderIndex.h
+ * @brief Secondary index that detects traces laid out on a regular lattice
+ */
+#ifndef REGULARGRIDHEADERINDEX_H_20141024
+#define	REGULARGRIDHEADERINDEX_H_20141024
+
+#include<impl/indexer/HeaderIndex.h>
+
+#include<cstddef>
+#include<unordered_map>
+#include<vector>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the HeaderIndex interface for keys (e.g. inline 
+     * and crossline) that lie on a regular lattice
+     * 
+     * Traces are stored in the file line by line: along each line (slow 
+     * field) the other field (fast field) advances by a constant stride. The
+     * index stores runs of consecutive traces that follow this pattern, each
+     * with its own signed stride, together with the range and the stride of 
+     * both fields. For a regular survey this amounts to one run per line, 
+     * whatever the number of traces and even if lines alternate direction, 
+     * and missing traces just split a line in more runs. Keys are not 
+     * retained once added to the runs, which are enough to recover them.
+     * 
+     * Lookups of a single key cost O(runs per line), while lookups of a whole 
+     * line along either field cost O(result). Keys that don't follow a regular
+     * pattern are still indexed correctly, at the price of shorter runs.
+     * 
+     * The cells of the lattice are numbered with the second field varying 
+     * fastest. Segments map runs of traces to cells, so that whole lines or 
+     * slices of a regular survey can be assembled with one read per run.
+     */
+    class RegularGridHeaderIndex : public HeaderIndex {
+    public:
+        /**
+         * @brief Values taken by a field: min + k * stride, for k in [0, size())
+         */
+        struct Axis {
+            int32_t min{0};
+            int32_t max{0};
+            /// Positive stride, or 0 if the field takes a single value
+            int32_t stride{0};
+            
+            /**
+             * @brief Returns the number of values on the axis
+             * 
+             * @return number of values
+             */
+            size_t size() const {
+                return stride == 0 ? 1 : static_cast<size_t>( (static_cast<int64_t>(max) - min) / stride + 1 );
+            }
+        };
+        
+        /**
+         * @brief Traces [trace, trace + count) fill the cells cell, cell + step, ... 
+         * of an output grid
+         */
+        struct Segment {
+            size_t trace;
+            size_t count;
+            size_t cell;
+            std::ptrdiff_t step;
+        };
+        
+        explicit RegularGridHeaderIndex(const HeaderKey& key);
+        
+        /**
+         * @brief Checks the sort order of the traces
+         * 
+         * The order is detected on the first two consecutive traces that 
+         * share exactly one field. Until then, traces are taken as sorted by 
+         * the first field.
+         * 
+         * @return true if traces are sorted by the first field (the second 
+         * field varies fastest), false otherwise
+         */
+        bool firstMajor() const;
+        
+        /**
+         * @brief Returns the axis of the first field
+         * 
+         * @return axis of the first field
+         */
+        const Axis& first() const;
+        
+        /**
+         * @brief Returns the axis of the second field
+         * 
+         * @return axis of the second field
+         */
+        const Axis& second() const;
+        
+        /**
+         * @brief Checks if every cell of the lattice holds at most one trace
+         * 
+         * @return true if no two traces have the same key
+         */
+        bool regular() const;
+        
+        /**
+         * @brief Returns the number of runs of traces
+         * 
+         * @return number of runs
+         */
+        size_t nruns() const;
+        
+        /**
+         * @brief Looks up the trace in a cell of the lattice
+         * 
+         * @param[in] key cell of the lattice
+         * @param[out] n id of the first trace in the cell, if any
+         * 
+         * @return true if the cell holds a trace, false otherwise
+         */
+        bool locate(const key_type& key, size_t& n) const;
+        
+        /**
+         * @brief Returns the traces whose second field is equal to a given value
+         * 
+         * @param[in] value value of the second field
+         * @return ids of the matching traces
+         */
+        result_type findSecond(const int32_t value) const;
+        
+        /**
+         * @brief Returns the traces whose first field is equal to a given value
+         * 
+         * Cells are positions along the second axis
+         * 
+         * @param[in] value value of the first field
+         * @return segments of matching traces, in trace order
+         */
+        std::vector<Segment> segmentsFirst(const int32_t value) const;
+        
+        /**
+         * @brief Returns the traces whose second field is equal to a given value
+         * 
+         * Cells are positions along the first axis
+         * 
+         * @param[in] value value of the second field
+         * @return segments of matching traces, in trace order
+         */
+        std::vector<Segment> segmentsSecond(const int32_t value) const;
+        
+        /**
+         * @brief Returns every trace in the index
+         * 
+         * Cells are positions on the lattice: the trace with key (first, 
+         * second) fills cell i * second().size() + j, where i and j are the 
+         * positions of first and second along their axis
+         * 
+         * @return segments of all traces, in trace order
+         */
+        std::vector<Segment> segments() const;
+        
+    private:
+        /// Consecutive traces on the same line, with equally spaced fast field
+        struct Run {
+            int32_t slow;
+            int32_t fast;
+            size_t count;
+            size_t trace;
+            /// Signed stride of the fast field, or 0 if the run holds a single trace
+            int32_t stride;
+        };
+        
+        /// Tracks the range of a field and the greatest common divisor of its spacing
+        struct AxisBuilder {
+            Axis axis;
+            int32_t origin{0};
+            bool empty{true};
+            
+            void add(const int32_t value);
+        };
+        
+        void clear_lookup() override;
+        
+        void extend_lookup(const size_t first) override;
+        
+        key_type lookup_key(const size_t n) const override;
+        
+        void lookup_keys(std::vector<key_type>& keys) const override;
+        
+        /// Adds trace n to the runs
+        void add(const size_t n, const key_type& key);
+        
+        /// Returns the key of the k-th trace of a run
+        key_type runKey(const Run& run, const size_t k) const;
+        
+        result_type find_key(const key_type& key) const override;
+        
+        result_type find_first(const int32_t value) const override;
+        
+        /// Finds the offset within a run of the trace whose fast field is equal to value
+        bool offset(const Run& run, const int32_t value, size_t& k) const;
+        
+        /// Appends the traces of a run whose fast field is equal to value
+        void match(const Run& run, const int32_t value, result_type& result) const;
+        
+        /// Returns the segments of the traces on a line (slow field), with cells along the fast axis
+        std::vector<Segment> segmentsSlow(const int32_t value) const;
+        
+        /// Returns the segments of the traces whose fast field is equal to value, with cells along the slow axis
+        std::vector<Segment> segmentsFast(const int32_t value) const;
+        
+        /// Returns the position of a value along an axis
+        static size_t cell(const Axis& axis, const int32_t value);
+        
+        const Axis& slow() const;
+        
+        const Axis& fast() const;
+        
+        /// Distance between the cells of two consecutive traces of a run, along the fast axis
+        std::ptrdiff_t step(const Run& run) const;
+        
+        /// Returns the traces on a line (slow field)
+        result_type findSlow(const int32_t value) const;
+        
+        /// Returns the traces whose fast field is equal to a given value
+        result_type findFast(const int32_t value) const;
+        
+        std::vector<Run> m_runs;
+        /// Indexes of the runs of each line
+        std::unordered_map< int32_t, std::vector<size_t> > m_lines;
+        bool m_first_major{true};
+        bool m_oriented{false};
+        AxisBuilder m_first;
+        AxisBuilder m_second;
+        size_t m_duplicates{0};
+    };
+    
+}
+
+#endif	/* REGULARGRIDHEADERINDEX_H_20141024 */
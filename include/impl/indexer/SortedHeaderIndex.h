@@ -0,0 +1,61 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SortedHeaderIndex.h
+ * @brief Secondary index based on a sorted array
+ */
+#ifndef SORTEDHEADERINDEX_H_20141024
+#define	SORTEDHEADERINDEX_H_20141024
+
+#include<impl/indexer/HeaderIndex.h>
+
+#include<utility>
+#include<vector>
+
+namespace seismic {
+    
+    /**
+     * @brief Implementation of the HeaderIndex interface that keeps (key, trace id)
+     * pairs in a sorted array
+     * 
+     * Lookups are binary searches, and cost O(log(n) + result). Appended 
+     * traces are sorted on their own and merged with the array.
+     */
+    class SortedHeaderIndex : public HeaderIndex {
+    public:
+        explicit SortedHeaderIndex(const HeaderKey& key);
+        
+    private:
+        void clear_lookup() override;
+        
+        void extend_lookup(const size_t first) override;
+        
+        result_type find_key(const key_type& key) const override;
+        
+        result_type find_first(const int32_t value) const override;
+        
+        std::vector< std::pair<key_type, size_t> > m_sorted;
+    };
+    
+}
+
+#endif	/* SORTEDHEADERINDEX_H_20141024 */
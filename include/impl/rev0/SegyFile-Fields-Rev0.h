@@ -59,103 +59,103 @@ namespace seismic {
             /// >
             /// > Job identification number
             /// >
-            extern const Int32Field jobID;
+            constexpr Int32Field jobID(0);
             /// >
             /// > Line number. For 3-D poststack data, this will typically contain the in-line number
             /// >
-            extern const Int32Field lineNumber;
+            constexpr Int32Field lineNumber(4);
             /// >
             /// > Reel number
             /// >
-            extern const Int32Field reelNumber;
+            constexpr Int32Field reelNumber(8);
 
             /// >
             /// > Number of data traces per ensemble. __Mandatory for prestack data__
             /// >
-            extern const Int16Field nDataTraces;
+            constexpr Int16Field nDataTraces(12);
             /// >
             /// > Number of auxiliary traces per ensemble. __Mandatory for prestack data__
             /// >
-            extern const Int16Field nAuxiliaryTraces;
+            constexpr Int16Field nAuxiliaryTraces(14);
             /// >
             /// > Sample interval in microseconds (µs). __Mandatory for all data types__
             /// >
-            extern const Int16Field sampleInterval;
+            constexpr Int16Field sampleInterval(16);
             /// >
             /// > Sample interval in microseconds (µs) of original field recording
             /// >
-            extern const Int16Field sampleIntervalOriginalField;
+            constexpr Int16Field sampleIntervalOriginalField(18);
             /// > Number of samples per data trace. __Mandatory for all types of data__ 
             /// >
             /// > The sample interval and number of samples in the Binary 
             /// > File Header should be for the primary set of seismic data traces in the file
-            extern const Int16Field nsamplesDataTrace;
+            constexpr Int16Field nsamplesDataTrace(20);
             /// >
             /// > Number of samples per data trace for original field recording
             /// >
-            extern const Int16Field nsamplesDataTraceOriginalField;
+            constexpr Int16Field nsamplesDataTraceOriginalField(22);
             /// > Data sample format code.  __Mandatory for all data__
             /// >
             /// > @see constants::SegyFileFormatCode
-            extern const Int16Field formatCode;
+            constexpr Int16Field formatCode(24);
             /// > The expected number of data traces per trace ensemble (e.g. the CMP fold).
             /// > __Highly recommended for all types of data__
-            extern const Int16Field ensembleFold;
+            constexpr Int16Field ensembleFold(26);
             /// > Trace sorting code (i.e. type of ensemble)
             /// > __Highly recommended for all types of data__
             /// >
             /// > @see constants::TraceSortingCode
-            extern const Int16Field traceSortingCode;
+            constexpr Int16Field traceSortingCode(28);
             /// > Vertical sum code
             /// > 
             /// > 1 = no sum,
             /// > 2 = two sum, 
             /// > …,
             /// > N = M-1 sum  (M = 2 to 32,767)
-            extern const Int16Field verticalSumCode;
+            constexpr Int16Field verticalSumCode(30);
             /// >
             /// > Sweep frequency at start (Hz)
             /// >
-            extern const Int16Field sweepFrequencyStart;
+            constexpr Int16Field sweepFrequencyStart(32);
             /// >
             /// > Sweep frequency at end (Hz)
             /// >
-            extern const Int16Field sweepFrequencyEnd;
+            constexpr Int16Field sweepFrequencyEnd(34);
             /// >
             /// > Sweep length (ms)
             /// >
-            extern const Int16Field sweepLength;
+            constexpr Int16Field sweepLength(36);
             /// >
             /// > Sweep type code
             /// >
             /// > @see constants::SweepTypeCode
-            extern const Int16Field sweepTypeID;
+            constexpr Int16Field sweepTypeID(38);
             /// >
             /// > Trace number of sweep channel
             /// >
-            extern const Int16Field traceNumberSweepChannel;
+            constexpr Int16Field traceNumberSweepChannel(40);
             /// > Sweep trace taper length in milliseconds at start if tapered 
             /// > (the taper starts at zero time and is effective for this length)
-            extern const Int16Field sweepTraceTaperLengthStart;
+            constexpr Int16Field sweepTraceTaperLengthStart(42);
             /// > Sweep trace taper length in milliseconds at end 
             /// > (the ending taper starts at sweep length minus the taper length at end)
-            extern const Int16Field sweepTraceTaperLengthEnd;
+            constexpr Int16Field sweepTraceTaperLengthEnd(44);
             /// > Taper type
             /// >
             /// > @see constants::TaperType
-            extern const Int16Field taperType;
+            constexpr Int16Field taperType(46);
             /// > Correlated data traces
             /// >
             /// > @see constants::CorrelatedDataTraces
-            extern const Int16Field correlatedDataTraces;
+            constexpr Int16Field correlatedDataTraces(48);
             /// > Binary gain recovered
             /// >
             /// > @see constants::BinaryGainRecovered
-            extern const Int16Field binaryGainRecovered;
+            constexpr Int16Field binaryGainRecovered(50);
             /// > Amplitude recovery method
             /// >
             /// > @see constants::AmplitudeRecoveryMethod
-            extern const Int16Field amplitudeRecoveryMethod;
+            constexpr Int16Field amplitudeRecoveryMethod(52);
             /// > Measurement system. __Highly recommended for all types of data__
             /// >
             /// > If Location Data stanzas are included in the file, this entry 
@@ -164,11 +164,11 @@ namespace seismic {
             /// > authority
             /// >
             /// > @see constants::Measurement system
-            extern const Int16Field measurementSystem;
+            constexpr Int16Field measurementSystem(54);
             /// > Impulse signal polarity
             /// >
             /// > @see constants::ImpulseSignalPolarity
-            extern const Int16Field impulseSignalPolarity;
+            constexpr Int16Field impulseSignalPolarity(56);
             /// > Vibratory polarity code
             /// >
             /// > Seismic signal lags pilot signal by:
@@ -180,7 +180,7 @@ namespace seismic {
             /// > 6 = 202.5° to 247.5°
             /// > 7 = 247.5° to 292.5°
             /// > 8 = 292.5° to 337.5°
-            extern const Int16Field vibratoryPolarityCode;
+            constexpr Int16Field vibratoryPolarityCode(58);
         }
 
         /**
@@ -202,37 +202,37 @@ namespace seismic {
             /// > Trace sequence number within line. __Highly recommended for all types of data__ 
             /// >
             /// > Numbers continue to increase if the same line continues across multiple SEG Y files            
-            extern const Int32Field traceSequenceNumberWithinLine;
+            constexpr Int32Field traceSequenceNumberWithinLine(0);
             /// > Trace sequence number within SEG Y file 
             /// >
             /// > Each file starts with trace sequence one
-            extern const Int32Field traceSequenceNumberWithinSEGY;
+            constexpr Int32Field traceSequenceNumberWithinSEGY(4);
             /// >
             /// > Original field record number. __Highly recommended for all types of data__
             /// >
-            extern const Int32Field originalFieldRecordNumber;
+            constexpr Int32Field originalFieldRecordNumber(8);
             /// >
             /// > Trace number within the original field record. __Highly recommended for all types of data__
             /// >
-            extern const Int32Field traceNumberWithinOriginalField;
+            constexpr Int32Field traceNumberWithinOriginalField(12);
             /// > Energy source point number 
             /// > 
             /// > Used when more than one record occurs at the same effective 
             /// > surface location. It is recommended that the new entry defined 
             /// > in Trace Header bytes 197-202 be used for shotpoint number
-            extern const Int32Field energySourcePointNumber;
+            constexpr Int32Field energySourcePointNumber(16);
             /// >
             /// > Ensemble number (i.e. CDP, CMP, CRP, etc.)
             /// >
-            extern const Int32Field ensembleNumber;
+            constexpr Int32Field ensembleNumber(20);
             /// > Trace number within the ensemble 
             /// > 
             /// > Each ensemble starts with trace number one
-            extern const Int32Field traceNumberWithinEnsemble;
+            constexpr Int32Field traceNumberWithinEnsemble(24);
             /// > Distance from center of the source point to the center of the receiver group 
             /// > 
             /// > Negative if opposite to direction in which line is shot
-            extern const Int32Field distanceFromCenterSourceToCenterReceiver;
+            constexpr Int32Field distanceFromCenterSourceToCenterReceiver(36);
             /// > Receiver group elevation (all elevations above the Vertical datum are positive and below are negative)
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -241,7 +241,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field receiverGroupElevation;
+            constexpr Int32Field receiverGroupElevation(40);
             /// > Surface elevation at source
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -250,7 +250,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field surfaceElevationAtSource;
+            constexpr Int32Field surfaceElevationAtSource(44);
             /// > Source depth below surface (a positive number)
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -259,7 +259,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field sourceDepthBelowSurface;
+            constexpr Int32Field sourceDepthBelowSurface(48);
             /// > Datum elevation at receiver group
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -268,7 +268,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field datumElevationAtReceiverGroup;
+            constexpr Int32Field datumElevationAtReceiverGroup(52);
             /// > Datum elevation at source
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -277,7 +277,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field datumElevationAtSource;
+            constexpr Int32Field datumElevationAtSource(56);
             /// > Water depth at source
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -286,7 +286,7 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field waterDepthAtSource;
+            constexpr Int32Field waterDepthAtSource(60);
             /// > Water depth at group
             /// >
             /// > The scalar in Trace Header bytes 69-70 applies to these values. 
@@ -295,27 +295,27 @@ namespace seismic {
             /// > 
             /// > The Vertical Datum should be defined through a Location Data 
             /// > stanza (see section D-1)
-            extern const Int32Field waterDepthAtGroup;
+            constexpr Int32Field waterDepthAtGroup(64);
             /// > Source coordinate ‑ X
             /// >
             /// > The coordinate reference system should be identified through an
             /// > extended header Location Data stanza (see section D-1).
-            extern const Int32Field sourceCoordinateX;
+            constexpr Int32Field sourceCoordinateX(72);
             /// > Source coordinate ‑ Y
             /// >
             /// > The coordinate reference system should be identified through an
             /// > extended header Location Data stanza (see section D-1).
-            extern const Int32Field sourceCoordinateY;
+            constexpr Int32Field sourceCoordinateY(76);
             /// > Group coordinate ‑ X
             /// >
             /// > The coordinate reference system should be identified through an
             /// > extended header Location Data stanza (see section D-1).
-            extern const Int32Field groupCoordinateX;
+            constexpr Int32Field groupCoordinateX(80);
             /// > Group coordinate ‑ Y
             /// >
             /// > The coordinate reference system should be identified through an
             /// > extended header Location Data stanza (see section D-1).
-            extern const Int32Field groupCoordinateY;
+            constexpr Int32Field groupCoordinateY(84);
 
             /// > Trace identification code. __Highly recommended for all types of data__
             ///> 
@@ -344,29 +344,29 @@ namespace seismic {
             /// > 21 = Vibrator reference
             /// > 22 = Time-velocity pairs
             /// > 23 … N = optional use,  (maximum N = 32,767)                 
-            extern const Int16Field traceIdentificationCode;
+            constexpr Int16Field traceIdentificationCode(28);
             /// > Number of vertically summed traces yielding this trace
             /// > 
             /// > 1 is one trace, 2 is two summed traces, etc.
-            extern const Int16Field numberOfVerticallySummedTraces;
+            constexpr Int16Field numberOfVerticallySummedTraces(30);
             /// > Number of horizontally stacked traces yielding this trace
             /// > 
             /// > 1 is one trace, 2 is two stacked traces, etc.
-            extern const Int16Field numberOfHorizontallyStackedTraces;
+            constexpr Int16Field numberOfHorizontallyStackedTraces(32);
             /// > 
             /// > Data use
             /// > 
-            extern const Int16Field dataUse;
+            constexpr Int16Field dataUse(34);
             /// > Scalar to be applied to all elevations and depths specified in Trace Header bytes 41‑68 to give the real value.
             /// > 
             /// > Scalar = 1, +10, +100, +1000, or +10,000. If positive, scalar is
             /// > used as a multiplier; if negative, scalar is used as a divisor
-            extern const Int16Field scalarElevation;
+            constexpr Int16Field scalarElevation(68);
             /// > Scalar to be applied to all coordinates specified in Trace Header bytes 73‑88 and to bytes Trace Header 181-188 to give the real value. 
             /// > 
             /// > Scalar = 1, +10, +100, +1000, or +10,000.  If positive, scalar is
             /// > used as a multiplier; if negative, scalar is used as divisor
-            extern const Int16Field scalarCoordinates;
+            constexpr Int16Field scalarCoordinates(70);
             /// > Coordinate units
             /// > 
             /// > Note: To encode ±DDDMMSS bytes 89-90 equal = ±DDD*104 + MM*102 + SS 
@@ -374,40 +374,40 @@ namespace seismic {
             /// > equal = ±DDD*106 + MM*104 + SS*102 with bytes 71-72 set to -100
             /// > 
             /// > @see constants::CoordinateUnits
-            extern const Int16Field coordinateUnits;
+            constexpr Int16Field coordinateUnits(88);
             /// > Weathering velocity
             /// > 
             /// > ft/s or m/s as specified in Binary File Header bytes 3255-3256
-            extern const Int16Field weatheringVelocity;
+            constexpr Int16Field weatheringVelocity(90);
             /// > Subweathering velocity
             /// > 
             /// > ft/s or m/s as specified in Binary File Header bytes 3255-3256
-            extern const Int16Field subweatheringVelocity;
+            constexpr Int16Field subweatheringVelocity(92);
             /// > Uphole time at source in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field upholeTimeAtSource;
+            constexpr Int16Field upholeTimeAtSource(94);
             /// > Uphole time at group in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field upholeTimeAtGroup;
+            constexpr Int16Field upholeTimeAtGroup(96);
             /// > Source static correction in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field sourceStaticCorrection;
+            constexpr Int16Field sourceStaticCorrection(98);
             /// > Group static correction in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field groupStaticCorrection;
+            constexpr Int16Field groupStaticCorrection(100);
             /// > Total static applied in milliseconds (zero if no static has been applied)
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field totalStaticApplied;
+            constexpr Int16Field totalStaticApplied(102);
             /// > Lag time A
             /// > 
             /// > Time in milliseconds between end of 240‑byte trace identification
@@ -419,7 +419,7 @@ namespace seismic {
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field lagTimeA;
+            constexpr Int16Field lagTimeA(104);
             /// > Lag time B
             /// > 
             /// > Time in milliseconds between time break and the initiation time 
@@ -427,7 +427,7 @@ namespace seismic {
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field lagTimeB;
+            constexpr Int16Field lagTimeB(106);
             /// > Delay recording time 
             /// > 
             /// > Time in milliseconds between initiation time of energy source 
@@ -442,21 +442,21 @@ namespace seismic {
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field delayRecordingTime;
+            constexpr Int16Field delayRecordingTime(108);
             /// > Mute time — Start time in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field muteTimeStart;
+            constexpr Int16Field muteTimeStart(110);
             /// > Mute time — End time in milliseconds
             /// > 
             /// > Time in milliseconds as scaled by the scalar specified in 
             /// > Trace Header bytes 215-216
-            extern const Int16Field muteTimeEnd;
+            constexpr Int16Field muteTimeEnd(112);
             /// > 
             /// > Number of samples in this trace. __Highly recommended for all types of data__
             /// > 
-            extern const Int16Field nsamplesTrace;
+            constexpr Int16Field nsamplesTrace(114);
             /// > Sample interval in microseconds (µs) for this trace. __Highly recommended for all types of data__
             /// > 
             /// > The number of bytes in a trace record must be consistent with 
@@ -470,86 +470,86 @@ namespace seismic {
             /// > recorded in the Binary File Header. If the fixed length trace 
             /// > flag is not set, the sample interval and number of samples may 
             /// > vary from trace to trace.
-            extern const Int16Field sampleInterval;
+            constexpr Int16Field sampleInterval(116);
             /// > Gain type of field instruments
             /// > 
             /// > 1 = fixed
             /// > 2 = binary
             /// > 3 = floating point
             /// > 4 … N = optional use
-            extern const Int16Field gainType;
+            constexpr Int16Field gainType(118);
             /// > 
             /// > Instrument gain constant (dB)
             /// > 
-            extern const Int16Field instrumentGainConstant;
+            constexpr Int16Field instrumentGainConstant(120);
             /// > 
             /// > Instrument early or initial gain (dB)
             /// > 
-            extern const Int16Field instrumentEarlyGain;
+            constexpr Int16Field instrumentEarlyGain(122);
             /// > Correlated
             /// > 
             /// > @see constants::CorrelatedDataTraces
-            extern const Int16Field correlated;
+            constexpr Int16Field correlated(124);
             /// > 
             /// > Sweep frequency at start (Hz)
             /// > 
-            extern const Int16Field sweepFrequencyStart;
+            constexpr Int16Field sweepFrequencyStart(126);
             /// > 
             /// > Sweep frequency at end (Hz)
             /// > 
-            extern const Int16Field sweepFrequencyEnd;
+            constexpr Int16Field sweepFrequencyEnd(128);
             /// > 
             /// > Sweep length in milliseconds
             /// > 
-            extern const Int16Field sweepLength;
+            constexpr Int16Field sweepLength(130);
             /// > Sweep type
             /// > 
             /// @see constants::SweepTypeCode
-            extern const Int16Field sweepType;
+            constexpr Int16Field sweepType(132);
             /// > 
             /// > Sweep trace taper length at start in milliseconds
             /// > 
-            extern const Int16Field sweepTraceTaperLengthStart;
+            constexpr Int16Field sweepTraceTaperLengthStart(134);
             /// >
             /// > Sweep trace taper length at end in milliseconds
             /// >
-            extern const Int16Field sweepTraceTaperLengthEnd;
+            constexpr Int16Field sweepTraceTaperLengthEnd(136);
             /// > Taper type
             /// >
             /// > @see constants::TaperType
-            extern const Int16Field taperType;
+            constexpr Int16Field taperType(138);
             /// >
             /// > Alias filter frequency (Hz), if used
             /// >
-            extern const Int16Field aliasFilterFrequency;
+            constexpr Int16Field aliasFilterFrequency(140);
             /// >
             /// > Alias filter slope (dB/octave)
             /// >
-            extern const Int16Field aliasFilterSlope;
+            constexpr Int16Field aliasFilterSlope(142);
             /// >
             /// > Notch filter frequency (Hz), if used
             /// >
-            extern const Int16Field notchFilterFrequency;
+            constexpr Int16Field notchFilterFrequency(144);
             /// >
             /// > Notch filter slope (dB/octave)
             /// >
-            extern const Int16Field notchFilterSlope;
+            constexpr Int16Field notchFilterSlope(146);
             /// >
             /// > Low-cut frequency (Hz), if used
             /// >
-            extern const Int16Field lowCutFrequency;
+            constexpr Int16Field lowCutFrequency(148);
             /// >
             /// > High-cut frequency (Hz), if used
             /// >
-            extern const Int16Field highCutFrequency;
+            constexpr Int16Field highCutFrequency(150);
             /// >
             /// > Low-cut slope (dB/octave)
             /// >
-            extern const Int16Field lowCutSlope;
+            constexpr Int16Field lowCutSlope(152);
             /// >
             /// > High-cut slope (dB/octave)
             /// >
-            extern const Int16Field highCutSlope;
+            constexpr Int16Field highCutSlope(154);
             /// > Year data recorded 
             /// >
             /// > The 1975 standard is unclear as to whether this should be 
@@ -557,52 +557,52 @@ namespace seismic {
             /// > For SEG Y revisions beyond rev 0, the year should be recorded 
             /// > as the complete 4-digit Gregorian calendar year (i.e. the year 
             /// > 2001 should be recorded as 2001 (0x7D1))
-            extern const Int16Field yearDataRecorded;
+            constexpr Int16Field yearDataRecorded(156);
             /// > Day of year 
             /// >
             /// > Julian day for GMT and UTC time basis
-            extern const Int16Field dayOfTheYear;
+            constexpr Int16Field dayOfTheYear(158);
             /// >
             /// > Hour of day (24 hour clock)
             /// >
-            extern const Int16Field hourOfDay;
+            constexpr Int16Field hourOfDay(160);
             /// >
             /// > Minute of hour
             /// >
-            extern const Int16Field minuteOfHour;
+            constexpr Int16Field minuteOfHour(162);
             /// >
             /// > Second of minute
             /// >
-            extern const Int16Field secondOfMinute;
+            constexpr Int16Field secondOfMinute(164);
             /// >
             /// > Time basis code
             /// >
-            extern const Int16Field timeBasisCode;
+            constexpr Int16Field timeBasisCode(166);
             /// > Trace weighting factor 
             /// >
             /// > Defined as 2‑N volts for the least significant bit.
             /// > (N = 0, 1, …, 32767)
-            extern const Int16Field traceWeightingFactor;
+            constexpr Int16Field traceWeightingFactor(168);
             /// >
             /// > Geophone group number of roll switch position one
             /// >
-            extern const Int16Field geophoneGroupNumberOfRollSwitch;
+            constexpr Int16Field geophoneGroupNumberOfRollSwitch(170);
             /// >
             /// > Geophone group number of trace number one within original field record
             /// >
-            extern const Int16Field geophoneGroupNumberOfTraceNumber;
+            constexpr Int16Field geophoneGroupNumberOfTraceNumber(172);
             /// >
             /// > Geophone group number of last trace within original field record
             /// >
-            extern const Int16Field geophoneGroupNumberOfLastTrace;
+            constexpr Int16Field geophoneGroupNumberOfLastTrace(174);
             /// >
             /// > Gap size (total number of groups dropped)
             /// >
-            extern const Int16Field gapSize;
+            constexpr Int16Field gapSize(176);
             /// >
             /// > Over travel associated with taper at beginning or end of line
             /// >
-            extern const Int16Field overTravel;
+            constexpr Int16Field overTravel(178);
         }
         
         /**
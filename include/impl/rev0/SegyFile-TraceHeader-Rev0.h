@@ -29,15 +29,26 @@ namespace seismic {
     template<>
     class ConcreteTraceHeader<Rev0> : public TraceHeader {
     public:
-        FACTORY_ADD_CREATE(ConcreteTraceHeader<Rev0>)
+        FACTORY_ADD_RECYCLING_CREATE(ConcreteTraceHeader<Rev0>)
         
         /* virtual */
         void print(std::ostream& cout) const;
         /* virtual */
         void invertByteOrder();
         /* virtual */
+        const ByteOrderPermutation<buffer_size> * byteOrderPermutation();
+        /* virtual */
         void checkConsistencyOrThrow() const;
         
+    protected:
+        /**
+         * @brief Returns the permutation that inverts the byte order of 
+         * every field of the header
+         * 
+         * @return reference to a static constant permutation
+         */
+        const ByteOrderPermutation<buffer_size>& permutation();
+        
     private:
         /**
          * @brief Returns a reference to a static vector used to 
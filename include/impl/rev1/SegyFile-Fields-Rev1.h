@@ -57,7 +57,7 @@ namespace seismic {
             /// > This field is mandatory for all versions of SEG Y, although a 
             /// > value of zero indicates “traditional” SEG Y conforming to the 
             /// > 1975 standard
-            extern const Int16Field segyFormatRevisionNumber;
+            constexpr Int16Field segyFormatRevisionNumber(300);
             /// > Fixed length trace flag
             /// >
             /// > A value of one indicates that all traces in this SEG Y file are 
@@ -71,7 +71,7 @@ namespace seismic {
             /// > each trace. This field is mandatory for all versions of SEG Y, 
             /// > although a value of zero indicates “traditional” SEG Y 
             /// > conforming to the 1975 standard.
-            extern const Int16Field fixedLengthTraceFlag;
+            constexpr Int16Field fixedLengthTraceFlag(302);
             /// > Number of 3200-byte, Extended Textual File Header records following the Binary Header
             /// >
             /// > A value of zero indicates there are no Extended Textual File 
@@ -91,7 +91,7 @@ namespace seismic {
             /// > positive value be recorded here.  This field is mandatory for
             /// > all versions of SEG Y, although a value of zero indicates 
             /// > “traditional” SEG Y conforming to the 1975 standard
-            extern const Int16Field nextendedTextualFileHeader;
+            constexpr Int16Field nextendedTextualFileHeader(304);
         }
 
         /**
@@ -112,24 +112,24 @@ namespace seismic {
             /// >
             /// > The coordinate reference system should be identified through an 
             /// > extended header Location Data stanza (see section D-1)
-            extern const Int32Field ensembleCoordinateX;
+            constexpr Int32Field ensembleCoordinateX(180);
             /// > Y coordinate of ensemble (CDP) position of this trace (scalar in bytes Trace Header 71-72 applies)
             /// >
             /// > The coordinate reference system should be identified through an
             /// > extended header Location Data stanza (see section D-1)
-            extern const Int32Field ensembleCoordinateY;
+            constexpr Int32Field ensembleCoordinateY(184);
             /// > For 3-D poststack data, this field should be used for the in-line number
             /// >
             /// > If one in-line per SEG Y file is being recorded, this value 
             /// > should be the same for all traces in the file and the same value
             /// > will be recorded in bytes 3205-3208 of the Binary File Header
-            extern const Int32Field inlineNumber;
+            constexpr Int32Field inlineNumber(188);
             /// > For 3-D poststack data, this field should be used for the cross-line number
             /// >
             /// > This will typically be the same value as the ensemble (CDP) 
             /// > number in Trace Header bytes 21-24, but this does not have to 
             /// > be the case
-            extern const Int32Field crosslineNumber;
+            constexpr Int32Field crosslineNumber(192);
             /// > Shotpoint number 
             /// >
             /// > This is probably only applicable to 2-D poststack data. 
@@ -138,7 +138,7 @@ namespace seismic {
             /// > particular trace. If this is not the case, there should be a 
             /// > comment in the Textual File Header explaining what the 
             /// > shotpoint number actually refers to
-            extern const Int32Field shotpointNumber;
+            constexpr Int32Field shotpointNumber(196);
             /// > Transduction Constant 
             /// >
             /// > The multiplicative constant used to convert the Data Trace 
@@ -147,7 +147,7 @@ namespace seismic {
             /// > complement integer (bytes 205-208) which is the mantissa and a 
             /// > two-byte, two's complement integer (bytes 209-210) which is the 
             /// > power of ten exponent (i.e. Bytes 205-208 * 10**Bytes 209-210)
-            extern const Int32Field transductionConstantMantissa;
+            constexpr Int32Field transductionConstantMantissa(204);
             /// > Source Measurement 
             /// > 
             /// > Describes the source effort used to generate the trace. The 
@@ -161,7 +161,7 @@ namespace seismic {
             /// > (bytes 225-228) which is the mantissa and a two-byte, two's 
             /// > complement integer (bytes 209-230) which is the power of ten 
             /// > exponent (i.e. Bytes 225-228 * 10**Bytes 229-230)
-            extern const Int32Field sourceMeasurementMantissa;
+            constexpr Int32Field sourceMeasurementMantissa(224);
 
             /// > Scalar to be applied to the shotpoint number in Trace Header bytes 197-200 to give the real value
             /// > 
@@ -170,11 +170,11 @@ namespace seismic {
             /// > an integer. A typical value will be -10, allowing shotpoint 
             /// > numbers with one decimal digit to the right of the decimal
             /// > point)
-            extern const Int16Field scalarShotpointNumber;
+            constexpr Int16Field scalarShotpointNumber(200);
             /// > Trace value measurement unit
             /// >
             /// > @see constants::MeasurementUnit
-            extern const Int16Field traceValueMeasurementUnit;
+            constexpr Int16Field traceValueMeasurementUnit(202);
             /// > Transduction Constant 
             /// >
             /// > The multiplicative constant used to convert the Data Trace 
@@ -183,7 +183,7 @@ namespace seismic {
             /// > complement integer (bytes 205-208) which is the mantissa and a 
             /// > two-byte, two's complement integer (bytes 209-210) which is the 
             /// > power of ten exponent (i.e. Bytes 205-208 * 10**Bytes 209-210)
-            extern const Int16Field transductionConstantExponent;
+            constexpr Int16Field transductionConstantExponent(208);
             /// > Transduction Units 
             /// >
             /// > The unit of measurement of the Data Trace samples after they 
@@ -191,7 +191,7 @@ namespace seismic {
             /// > Trace Header bytes 205-210
             /// >
             /// > @see constants::MeasurementUnit
-            extern const Int16Field transductionUnits;
+            constexpr Int16Field transductionUnits(210);
             /// > Device/Trace Identifier 
             /// >
             /// > The unit number or id number of the device associated with the 
@@ -199,13 +199,13 @@ namespace seismic {
             /// > for gun 16 on string 3 on vessel 2). This field allows traces 
             /// > to be associated across trace ensembles independently of the 
             /// > trace number (Trace Header bytes 25-28)
-            extern const Int16Field traceIdentifier;
+            constexpr Int16Field traceIdentifier(212);
             /// > Scalar to be applied to times specified in Trace Header bytes 95-114 to give the true time value in milliseconds
             /// >
             /// > Scalar = 1, +10, +100, +1000, or +10,000.  If positive, scalar 
             /// > is used as a multiplier; if negative, scalar is used as divisor.
             /// > A value of zero is assumed to be a scalar value of 1
-            extern const Int16Field scalarTime;
+            constexpr Int16Field scalarTime(214);
             /// > Source Type/Orientation
             /// >
             /// > Defines the type and the orientation of the energy source. The
@@ -225,7 +225,7 @@ namespace seismic {
             /// >        7 = Distributed Impulsive - Vertical orientation
             /// >        8 = Distributed Impulsive - Cross-line orientation
             /// >        9 = Distributed Impulsive - In-line orientation
-            extern const Int16Field sourceOrientation;
+            constexpr Int16Field sourceOrientation(216);
             /// > Source Measurement 
             /// > 
             /// > Describes the source effort used to generate the trace. The 
@@ -239,7 +239,7 @@ namespace seismic {
             /// > (bytes 225-228) which is the mantissa and a two-byte, two's 
             /// > complement integer (bytes 209-230) which is the power of ten 
             /// > exponent (i.e. Bytes 225-228 * 10**Bytes 229-230)
-            extern const Int16Field sourceMeasurementExponent;
+            constexpr Int16Field sourceMeasurementExponent(228);
             /// > Source Measurement Unit 
             /// >
             /// > The unit used for the Source Measurement, Trace header bytes 225-230.
@@ -252,7 +252,7 @@ namespace seismic {
             /// >  4 = Bar-meter (Bar-m)
             /// >  5 = Newton (N)
             /// >  6 = Kilograms (kg)
-            extern const Int16Field sourceMeasurementUnit;
+            constexpr Int16Field sourceMeasurementUnit(230);
         }
         
         /**
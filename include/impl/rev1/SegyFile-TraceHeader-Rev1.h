@@ -29,15 +29,26 @@ namespace seismic {
     template<>
     class ConcreteTraceHeader<Rev1> : public ConcreteTraceHeader<Rev0> {
     public:
-        FACTORY_ADD_CREATE(ConcreteTraceHeader<Rev1>)
+        FACTORY_ADD_RECYCLING_CREATE(ConcreteTraceHeader<Rev1>)
                         
         /* virtual */
         void print(std::ostream& cout) const;
         /* virtual */
         void invertByteOrder();
         /* virtual */
+        const ByteOrderPermutation<buffer_size> * byteOrderPermutation();
+        /* virtual */
         void checkConsistencyOrThrow() const;
         
+    protected:
+        /**
+         * @brief Returns the permutation that inverts the byte order of 
+         * every field of the header
+         * 
+         * @return reference to a static constant permutation
+         */
+        const ByteOrderPermutation<buffer_size>& permutation();
+        
     private:
         /**
          * @brief Static vector used to iterate over all the items of a
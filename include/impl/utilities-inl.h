@@ -28,6 +28,7 @@
 
 #include<algorithm>
 #include<cstdint>
+#include<cstring>
 
 namespace seismic {
 
@@ -35,6 +36,13 @@ namespace seismic {
     //// Byte order 
     ////////////////////            
     
+    /// True if values stored in a SEG-Y file (big-endian) must be swapped on this platform
+#ifdef LITTLE_ENDIAN
+    constexpr bool littleEndianHost = true;
+#else
+    constexpr bool littleEndianHost = false;
+#endif
+    
     /**
      * @brief Invert in place the byte order of a generic object in memory
      * 
@@ -60,6 +68,100 @@ namespace seismic {
         std::reverse(stream,stream+size);
     }    
     
+    /// Instruction sets of the vectorized kernels, from the narrowest to the widest
+    enum class InstructionSet { Scalar, SSE2, AVX2, AVX512 };
+    
+    /**
+     * @brief Widest instruction set supported by the CPU
+     * 
+     * This is the one selected at start-up for the vectorized kernels.
+     */
+    InstructionSet widestInstructionSet();
+    
+    /**
+     * @brief Selects the kernels used by swapByteOrder, permuteBytes and the array 
+     * conversions between IBM and IEEE-754 formats
+     * 
+     * Meant for tests and benchmarks, which need to exercise every kernel 
+     * the CPU supports. It is not safe to call while conversions run in 
+     * other threads.
+     * 
+     * @param[in] set instruction set of the kernels
+     * @return false, leaving the kernels unchanged, if the CPU doesn't support the instruction set
+     */
+    bool selectInstructionSet(const InstructionSet set);
+    
+    /**
+     * @brief Invert the byte order of each element of an array
+     * 
+     * The work is dispatched at run-time to the widest vectorized kernel 
+     * supported by the CPU (AVX-512, AVX2 or SSE2 on x86), with a scalar 
+     * fallback on other platforms.
+     * 
+     * @param[in] source pointer to the first element to be converted
+     * @param[out] destination pointer to the first converted element (may be equal to source)
+     * @param[in] nelements number of elements
+     * @param[in] elementSize size of a single element in bytes (1, 2, 4 or 8)
+     */
+    void swapByteOrder(const char * source, char * destination, const size_t nelements, const size_t elementSize);
+    
+    /**
+     * @brief Invert in place the byte order of each element of an array
+     * 
+     * @param[in,out] stream pointer to the first element
+     * @param[in] nelements number of elements
+     * @param[in] elementSize size of a single element in bytes (1, 2, 4 or 8)
+     */
+    inline void swapByteOrder(char * stream, const size_t nelements, const size_t elementSize) {
+        swapByteOrder(stream, stream, nelements, elementSize);
+    }
+    
+    /**
+     * @brief Permutes the bytes of a stream, 16 bytes at a time
+     * 
+     * Byte ii of the destination is byte permutation[ii] of the 16-byte block
+     * of the source that contains ii. The permutation is performed with a 
+     * single byte shuffle per block, if the CPU supports it (SSSE3 on x86).
+     * 
+     * @param[in] source pointer to the first byte to be permuted
+     * @param[out] destination pointer to the first permuted byte (may be equal to source)
+     * @param[in] permutation position of each byte within its block (values in [0, 16))
+     * @param[in] size number of bytes, a multiple of 16
+     */
+    void permuteBytes(const char * source, char * destination, const uint8_t * permutation, const size_t size);
+    
+    /**
+     * @brief Decodes a built-in type stored in big-endian byte order
+     * 
+     * @tparam T type of the object
+     * 
+     * @param[in] stream pointer to the first byte of the object
+     * @return decoded value in native byte order
+     */
+    template< class T >
+    inline T readBigEndian(const char * stream) {
+        T value;
+        std::memcpy(&value, stream, sizeof(T));
+#ifdef LITTLE_ENDIAN
+        invertByteOrder(value);
+#endif
+        return value;
+    }
+    
+    /**
+     * @brief Encodes a value in big-endian byte order into a stream
+     * 
+     * @param[in] value value in native byte order
+     * @param[out] stream pointer to the first byte of the encoded value
+     */
+    template< class T >
+    inline void writeBigEndian(T value, char * stream) {
+#ifdef LITTLE_ENDIAN
+        invertByteOrder(value);
+#endif
+        std::memcpy(stream, &value, sizeof(T));
+    }
+    
     ////////////////////
     //// Format conversion
     ////////////////////            
@@ -107,6 +209,34 @@ namespace seismic {
         value = fconv;
     }
     
+    /**
+     * @brief Convert an array of 4 bytes values from IBM floating point format to IEEE-754 format
+     * 
+     * The conversion is branch-free and vectorized (with run-time dispatch, as 
+     * swapByteOrder), and yields the very same bits as ibm2ieee(int32_t&). If 
+     * requested, the byte order of each value is inverted before the conversion.
+     * 
+     * @param[in] source pointer to the first value to be converted
+     * @param[out] destination pointer to the first converted value (may be equal to source)
+     * @param[in] nvalues number of values
+     * @param[in] swapBytes true if the source values must be byte swapped
+     */
+    void ibm2ieee(const char * source, char * destination, const size_t nvalues, const bool swapBytes);
+    
+    /**
+     * @brief Convert an array of 4 bytes values from IEEE-754 format to IBM floating point format
+     * 
+     * The conversion is branch-free and vectorized (with run-time dispatch, as 
+     * swapByteOrder), and yields the very same bits as ieee2ibm(int32_t&). If 
+     * requested, the byte order of each value is inverted after the conversion.
+     * 
+     * @param[in] source pointer to the first value to be converted
+     * @param[out] destination pointer to the first converted value (may be equal to source)
+     * @param[in] nvalues number of values
+     * @param[in] swapBytes true if the converted values must be byte swapped
+     */
+    void ieee2ibm(const char * source, char * destination, const size_t nvalues, const bool swapBytes);
+    
     /// Mapping from EBCDIC format to ASCII format
     extern const unsigned char e2a[256];
     /// Mapping from ASCII format to EBCDIC format
@@ -21,12 +21,17 @@
 #include<SegyFile.h>
 
 #include<impl/SegyFileIndexer.h>
+#include<impl/SegyFileBackend.h>
+#include<impl/SegyFile-HeaderColumns.h>
+#include<impl/indexer/HeaderIndex.h>
+#include<impl/indexer/RegularGridHeaderIndex.h>
 #include<impl/rev0/SegyFile-BinaryFileHeader-Rev0.h>
 #include<impl/utilities-inl.h>
 
 /// @todo REMOVE THESE INCLUDES
 #include<impl/SegyFileLazyWriter.h>
 
+#include<algorithm>
 #include<type_traits>
 #include<typeinfo>
 
@@ -35,10 +40,24 @@ using namespace boost::filesystem;
 
 namespace seismic {
 
-    SegyFile::SegyFile(const char * filename, const std::string & revision_tag, const std::string & indexer_tag)
+    namespace {
+        /// Largest gap between two trace headers that is read through, rather than skipped
+        const streamoff max_skipped_bytes = 4096;
+        /// Largest read performed when gathering trace headers
+        const streamoff header_window_size = 1 << 20;
+    }
+
+    SegyFile::SegyFile(const char * filename, const std::string & revision_tag, const std::string & indexer_tag, const std::string & backend_tag,
+            const std::vector< std::shared_ptr<HeaderIndex> >& header_indexes)
     : filePath_(filename), tfh_( make_shared<TextualFileHeader>() )
     , bfh_(BinaryFileHeader::create(revision_tag))
-    , tag_(revision_tag) {
+    , tag_(revision_tag), thPrototype_(TraceHeader::create(revision_tag))
+    , thPermutation_(thPrototype_->byteOrderPermutation()) {
+        if (thPermutation_ == nullptr) {
+            stringstream estream;
+            estream << "Trace header error : revision \"" << revision_tag << "\" provides no byte order permutation" << endl;
+            throw runtime_error(estream.str());
+        }
         //////////
         // If the file does not exist create it
         // and add enough space for TFH and BFH
@@ -63,9 +82,23 @@ namespace seismic {
         //////////
         // Create index to have random access later
         indexer_ = SegyFileIndexer::create(indexer_tag);
+        for (auto& x : header_indexes) {
+            indexer_->attach_header_index(x);
+        }
         indexer_->reset_segy_file(*this);
         indexer_->create_index();
-        writer_ = make_shared<SegyFileLazyWriter>(*indexer_, fstream_);
+        writer_ = make_shared<SegyFileLazyWriter>(*indexer_, fstream_, filePath_, *thPermutation_);
+        //////////
+
+        //////////
+        // Create the backend that will serve trace reads
+        backend_ = SegyFileBackend::create(backend_tag);
+        backend_->reset_segy_file(*this);
+        //////////
+        
+        //////////
+        // Complete secondary indexes, if the indexer didn't scan every header
+        updateHeaderIndexes();
         //////////
     }
 
@@ -104,31 +137,266 @@ namespace seismic {
     }
 
     SegyFile::raw_trace_type SegyFile::readRawTrace(const size_t n) {
-        TraceHeader::smart_reference_type th(TraceHeader::create(tag_));
+        raw_trace_type trace;
+        readRawTraceInto(n, trace);
+        return trace;
+    }
+
+    void SegyFile::readRawTraceInto(const size_t n, raw_trace_type& trace) {
+        if (!trace.first) {
+            trace.first = TraceHeader::smart_reference_type(thPrototype_->create());
+        }
         // Read trace header
         auto fposition = indexer_->position(n);
-        fstream_.seekg(fposition);
-        read(fstream_, th);
+        backend_->read(fposition, trace.first.get(), TraceHeader::buffer_size);
+        decodeTraceHeader(trace.first.get(), trace.first.get());
         // Read trace data
         size_t sizeOfDataSample = constants::sizeOfDataSample((*bfh_)[rev0::bfh::formatCode]);
         auto nSamples = indexer_->nsamples(n);
-        trace_data_type td;
-        read(fstream_, td, nSamples, sizeOfDataSample);
-        return make_pair(th, td);
+        read(*backend_, fposition + static_cast<streamoff>(TraceHeader::buffer_size), trace.second, nSamples, sizeOfDataSample);
+    }
+
+    TraceView SegyFile::viewTrace(const size_t n) {
+        auto format = (*bfh_)[rev0::bfh::formatCode];
+        auto nSamples = indexer_->nsamples(n);
+        auto traceSize = TraceHeader::buffer_size + nSamples * constants::sizeOfDataSample(format);
+        auto data = backend_->data(indexer_->position(n), traceSize);
+        if (data == nullptr) {
+            stringstream estream;
+            estream << "Backend error : the backend of " << filePath_ << " can't expose trace bytes directly" << endl;
+            estream << "\tuse a \"MemoryMapped\" backend or provide a buffer" << endl;
+            throw runtime_error(estream.str());
+        }
+        return TraceView(data, nSamples, format);
+    }
+
+    TraceView SegyFile::viewTrace(const size_t n, std::vector<char>& buffer) {
+        auto format = (*bfh_)[rev0::bfh::formatCode];
+        auto nSamples = indexer_->nsamples(n);
+        auto traceSize = TraceHeader::buffer_size + nSamples * constants::sizeOfDataSample(format);
+        auto fposition = indexer_->position(n);
+        auto data = backend_->data(fposition, traceSize);
+        if (data == nullptr) {
+            buffer.resize(traceSize);
+            backend_->read(fposition, buffer.data(), traceSize);
+            data = buffer.data();
+        }
+        return TraceView(data, nSamples, format);
+    }
+
+    void SegyFile::scanTraceHeaders(const header_visitor_type& visitor, const size_t first, const size_t last) {
+        trace_data_type window;
+        auto stop = min(last, ntraces());
+        size_t ii = first;
+        while (ii < stop) {
+            auto begin = indexer_->position(ii);
+            auto data = backend_->data(begin, TraceHeader::buffer_size);
+            if (data != nullptr) {
+                visitor(ii, TraceHeaderView(data));
+                ++ii;
+                continue;
+            }
+            // Gather the headers of short traces in a single read
+            auto end = begin + static_cast<streamoff>(TraceHeader::buffer_size);
+            size_t jj = ii + 1;
+            for (; jj < stop; ++jj) {
+                auto position = indexer_->position(jj);
+                if (position - end > max_skipped_bytes || position - begin + static_cast<streamoff>(TraceHeader::buffer_size) > header_window_size) {
+                    break;
+                }
+                end = position + static_cast<streamoff>(TraceHeader::buffer_size);
+            }
+            window.resize(static_cast<size_t>(end - begin));
+            backend_->read(begin, window.data(), window.size());
+            for (; ii < jj; ++ii) {
+                visitor(ii, TraceHeaderView(window.data() + (indexer_->position(ii) - begin)));
+            }
+        }
     }
 
     void SegyFile::overwriteRawTrace(const raw_trace_type& trace, const size_t n) {
-        writer_->addToOverwriteQueue(trace, n);
+        writer_->addToOverwriteQueue(trace, n, constants::sizeOfDataSample((*bfh_)[rev0::bfh::formatCode]));
+    }
+
+    void SegyFile::overwriteTraceHeader(const TraceHeader::smart_reference_type& header, const size_t n) {
+        writer_->addToHeaderOverwriteQueue(header, n);
+    }
+
+    void SegyFile::overwriteHeaderColumns(const HeaderColumns& columns, const size_t first) {
+        if (columns.size() > ntraces() || first > ntraces() - columns.size()) {
+            stringstream estream;
+            estream << "Trying to patch the headers of " << columns.size() << " traces from trace " << first << endl;
+            estream << "\tSEG-Y file : " << filePath_ << endl;
+            estream << "\tnumber of traces : " << ntraces() << endl;
+            throw out_of_range(estream.str());
+        }
+        for (size_t ii = 0; ii < columns.ncolumns(); ++ii) {
+            if (columns.column(ii).size() != columns.size()) {
+                stringstream estream;
+                estream << "Header columns error : column " << ii << " holds " << columns.column(ii).size() << " values instead of " << columns.size() << endl;
+                throw runtime_error(estream.str());
+            }
+        }
+        // The number of samples must not change, or the file would not match its index
+        if (columns.contains(rev0::th::nsamplesTrace)) {
+            const auto& nsamples = columns[rev0::th::nsamplesTrace];
+            for (size_t ii = 0; ii < columns.size(); ++ii) {
+                if (static_cast<uint16_t>(nsamples[ii]) != indexer_->nsamples(first + ii)) {
+                    stringstream estream;
+                    estream << "Trying to overwrite a trace header with different number of samples" << endl;
+                    estream << "\ttrace           : " << first + ii << endl;
+                    estream << "\texpected number : " << indexer_->nsamples(first + ii) << endl;
+                    estream << "\tactually got    : " << static_cast<uint16_t>(nsamples[ii]) << endl;
+                    throw runtime_error(estream.str());
+                }
+            }
+        }
+        // Patch the headers in the overwrite queue, so that they are written in runs
+        scanTraceHeaders([this, &columns, first](const size_t n, const TraceHeaderView& header) {
+            columns.store(n - first, writer_->headerOverwriteSlot(n, header.get()));
+        }, first, first + columns.size());
+        commitTraceModifications();
     }
 
     void SegyFile::appendRawTrace(const raw_trace_type& trace) {
         writer_->addToAppendQueue(trace, constants::sizeOfDataSample((*bfh_)[rev0::bfh::formatCode]));
     }
 
+    void SegyFile::setAppendMemoryBudget(const size_t bytes) {
+        writer_->setMemoryBudget(bytes);
+    }
+
     void SegyFile::commitTraceModifications() {
         writer_->commit(constants::sizeOfDataSample((*bfh_)[rev0::bfh::formatCode]));
+        // Make the modifications visible to the backend
+        fstream_.flush();
+        backend_->update();
+        updateHeaderIndexes();
+    }
+    
+    void SegyFile::attachHeaderIndex(const std::shared_ptr<HeaderIndex>& index) {
+        indexer_->attach_header_index(index);
+        updateHeaderIndexes();
+    }
+    
+    void SegyFile::updateHeaderIndexes() {
+        for (auto& x : indexer_->header_indexes()) {
+            scanTraceHeaders([&x](const size_t n, const TraceHeaderView& header) {
+                x->insert(n, header.get());
+            }, x->size());
+            x->update();
+        }
     }
 
+    const RegularGridHeaderIndex& SegyFile::geometry() const {
+        for (auto& x : indexer_->header_indexes()) {
+            auto grid = dynamic_cast<const RegularGridHeaderIndex *>(x.get());
+            if (grid == nullptr || grid->key().size() != 2) {
+                continue;
+            }
+            if (!grid->regular()) {
+                stringstream estream;
+                estream << "Geometry error : the inline/crossline lattice of " << filePath_ << " is not regular" << endl;
+                estream << "\tsome cells hold more than one trace" << endl;
+                throw runtime_error(estream.str());
+            }
+            return *grid;
+        }
+        stringstream estream;
+        estream << "Geometry error : no RegularGridHeaderIndex is attached to " << filePath_ << endl;
+        throw runtime_error(estream.str());
+    }
+    
+    size_t SegyFile::traceIndex(const int32_t il, const int32_t xl) const {
+        size_t n;
+        if (!geometry().locate(HeaderIndex::key_type(il, xl), n)) {
+            stringstream estream;
+            estream << "No trace at inline " << il << ", crossline " << xl << endl;
+            estream << "\tSEG-Y file : " << filePath_ << endl;
+            throw out_of_range(estream.str());
+        }
+        return n;
+    }
+    
+    void SegyFile::readHeaderColumns(HeaderColumns& columns) {
+        scanTraceHeaders([&columns](const size_t, const TraceHeaderView& header) {
+            columns.push_back(header.get());
+        }, columns.size());
+    }
+    
+    void SegyFile::readHeaderColumns(HeaderColumns& columns, const boost::filesystem::path& cache) {
+        IndexSignature signature;
+        bool reused = columns.load(cache, signature) && matchesSignature(signature, columns);
+        if (!reused) {
+            columns.clear();
+        }
+        auto nrecorded = columns.size();
+        readHeaderColumns(columns);
+        if (!reused || columns.size() != nrecorded) {
+            columns.save(cache, headerSignature(columns.size()));
+        }
+    }
+    
+    IndexSignature SegyFile::headerSignature(const size_t n) {
+        IndexSignature signature;
+        signature.segy_size = file_size(filePath_);
+        signature.segy_mtime = static_cast<int64_t>( last_write_time(filePath_) );
+        if (n != 0) {
+            char header[TraceHeader::buffer_size];
+            backend_->read(indexer_->position(0), header, TraceHeader::buffer_size);
+            signature.first_header_checksum = IndexSignature::checksum(header, TraceHeader::buffer_size);
+            backend_->read(indexer_->position(n - 1), header, TraceHeader::buffer_size);
+            signature.last_header_checksum = IndexSignature::checksum(header, TraceHeader::buffer_size);
+        }
+        return signature;
+    }
+    
+    bool SegyFile::matchesSignature(const IndexSignature& signature, const HeaderColumns& columns) {
+        auto n = columns.size();
+        if (n > ntraces()) {
+            return false;
+        }
+        auto current = headerSignature(n);
+        if (current.segy_size < signature.segy_size) {
+            return false;
+        } else if (current.segy_size == signature.segy_size && current.segy_mtime != signature.segy_mtime) {
+            return false;
+        }
+        if (current.first_header_checksum != signature.first_header_checksum ||
+                current.last_header_checksum != signature.last_header_checksum) {
+            return false;
+        }
+        if (current.segy_size == signature.segy_size) {
+            // The file has not been modified since the signature was computed
+            return true;
+        }
+        // A larger file may have been patched in place as well as appended 
+        // to: every header the columns were read from must be verified
+        auto block = HeaderColumns::checksum_block;
+        if (columns.checksums().size() != (n + block - 1) / block) {
+            return false;
+        }
+        vector<uint64_t> checksums;
+        checksums.reserve(columns.checksums().size());
+        scanTraceHeaders([&checksums, block](const size_t ii, const TraceHeaderView& header) {
+            if (ii % block == 0) {
+                checksums.push_back(IndexSignature::checksum(nullptr, 0));
+            }
+            checksums.back() = IndexSignature::checksum(header.get(), TraceHeader::buffer_size, checksums.back());
+        }, 0, n);
+        return checksums == columns.checksums();
+    }
+    
+    void SegyFile::decodeTraceHeader(const char * source, char * destination) const {
+#ifdef LITTLE_ENDIAN
+        thPermutation_->apply(source, destination);
+#else
+        if (source != destination) {
+            copy(source, source + TraceHeader::buffer_size, destination);
+        }
+#endif
+    }
+    
     SegyFile::~SegyFile() {
         commitTraceModifications();
     }
@@ -139,37 +407,165 @@ namespace seismic {
 
     template<class T>
     Trace<T> SegyFile::readTraceAs(const size_t n) {
+        Trace<T> trace(TraceHeader::smart_reference_type(thPrototype_->create()));
+        readTraceInto(n, trace);
+        return trace;
+    }
+
+    template Trace<float> SegyFile::readTraceAs<float> (const size_t n);
+    template Trace<int32_t> SegyFile::readTraceAs<int32_t>(const size_t n);
+    template Trace<int16_t> SegyFile::readTraceAs<int16_t>(const size_t n);
+    template Trace<int8_t> SegyFile::readTraceAs<int8_t> (const size_t n);
+
+    template<class T>
+    void SegyFile::readTraceInto(const size_t n, Trace<T>& trace) {
         auto encoding_format = (*bfh_)[rev0::bfh::formatCode];
         // Check consistency
         checkConsistencyWithType<T>();
+        TraceHeader::smart_reference_type& header = trace;
+        if (!header) {
+            header = TraceHeader::smart_reference_type(thPrototype_->create());
+        }
         // Read trace header
-        TraceHeader::smart_reference_type th(TraceHeader::create(tag_));
         auto fposition = indexer_->position(n);
-        fstream_.seekg(fposition);
-        read(fstream_, th);
+        backend_->read(fposition, trace.get(), TraceHeader::buffer_size);
+        decodeTraceHeader(trace.get(), trace.get());
         // Read trace data
-        Trace<T> trace(th);
         trace.resize(indexer_->nsamples(n));
-        read(fstream_, trace);
-        // Convert IBMfloat32 to IEEE754
+        auto dposition = fposition + static_cast<streamoff>(TraceHeader::buffer_size);
         if (encoding_format == constants::SegyFileFormatCode::IBMfloat32) {
-            for (auto & x : trace) {
-                int32_t * pnt = reinterpret_cast<int32_t *> (&x);
-                ibm2ieee(*pnt);
+            // Convert IBMfloat32 to IEEE754, swapping bytes in the same pass
+            char * bytes = reinterpret_cast<char *> (trace.data());
+            backend_->read(dposition, bytes, trace.size() * sizeof (T));
+            ibm2ieee(bytes, bytes, trace.size(), littleEndianHost);
+        } else {
+            read(*backend_, dposition, trace);
+        }
+    }
+
+    template void SegyFile::readTraceInto<float >(const size_t n, Trace<float >& trace);
+    template void SegyFile::readTraceInto<int32_t>(const size_t n, Trace<int32_t>& trace);
+    template void SegyFile::readTraceInto<int16_t>(const size_t n, Trace<int16_t>& trace);
+    template void SegyFile::readTraceInto<int8_t >(const size_t n, Trace<int8_t >& trace);
+
+    template<class T>
+    std::future< Trace<T> > SegyFile::readTraceAsync(const size_t n) {
+        auto ibm = (*bfh_)[rev0::bfh::formatCode] == constants::SegyFileFormatCode::IBMfloat32;
+        // Check consistency
+        checkConsistencyWithType<T>();
+        // State shared with the completion
+        struct Pending {
+            std::promise< Trace<T> > promise;
+            Trace<T> trace;
+            vector<char> bytes;
+        };
+        auto pending = make_shared<Pending>(Pending{std::promise< Trace<T> >(), Trace<T>(TraceHeader::smart_reference_type(thPrototype_->create())), vector<char>()});
+        pending->trace.resize(indexer_->nsamples(n));
+        pending->bytes.resize(TraceHeader::buffer_size + pending->trace.size() * sizeof (T));
+        auto future = pending->promise.get_future();
+        auto permutation = thPermutation_;
+        backend_->readAsync(indexer_->position(n), pending->bytes.data(), pending->bytes.size(), [pending, ibm, permutation](exception_ptr error) {
+            if (error) {
+                pending->promise.set_exception(error);
+                return;
+            }
+            auto& trace = pending->trace;
+            const char * bytes = pending->bytes.data();
+#ifdef LITTLE_ENDIAN
+            permutation->apply(bytes, trace.get());
+#else
+            copy(bytes, bytes + TraceHeader::buffer_size, trace.get());
+#endif
+            bytes += TraceHeader::buffer_size;
+            if (ibm) {
+                ibm2ieee(bytes, reinterpret_cast<char *> (trace.data()), trace.size(), littleEndianHost);
+            } else if (littleEndianHost) {
+                swapByteOrder(bytes, reinterpret_cast<char *> (trace.data()), trace.size(), sizeof (T));
+            } else {
+                copy(bytes, bytes + trace.size() * sizeof (T), reinterpret_cast<char *> (trace.data()));
+            }
+            pending->promise.set_value(move(trace));
+        });
+        return future;
+    }
+
+    template std::future< Trace<float> > SegyFile::readTraceAsync<float >(const size_t n);
+    template std::future< Trace<int32_t> > SegyFile::readTraceAsync<int32_t>(const size_t n);
+    template std::future< Trace<int16_t> > SegyFile::readTraceAsync<int16_t>(const size_t n);
+    template std::future< Trace<int8_t> > SegyFile::readTraceAsync<int8_t >(const size_t n);
+
+    template<class T>
+    void SegyFile::readTracesAs(const size_t first, const size_t count, T * samples, const size_t stride, char * headers) {
+        if (count == 0) {
+            return;
+        }
+        auto encoding_format = (*bfh_)[rev0::bfh::formatCode];
+        // Check consistency
+        checkConsistencyWithType<T>();
+        if (count > ntraces() || first > ntraces() - count) {
+            stringstream estream;
+            estream << "Trying to read " << count << " traces from trace " << first << endl;
+            estream << "\tSEG-Y file : " << filePath_ << endl;
+            estream << "\tnumber of traces : " << ntraces() << endl;
+            throw out_of_range(estream.str());
+        }
+        // Check the whole range before any output is written
+        for (size_t ii = 0; ii < count; ++ii) {
+            auto nSamples = indexer_->nsamples(first + ii);
+            if (nSamples > stride) {
+                stringstream estream;
+                estream << "Trace " << first + ii << " does not fit the stride of the output buffer" << endl;
+                estream << "\tnumber of samples : " << nSamples << endl;
+                estream << "\tstride            : " << stride << endl;
+                throw runtime_error(estream.str());
+            }
+        }
+        // Fetch the whole range with a single I/O operation
+        auto last = first + count - 1;
+        auto begin = indexer_->position(first);
+        auto end = indexer_->position(last) + static_cast<streamoff>(TraceHeader::buffer_size + indexer_->nsamples(last) * sizeof (T));
+        auto nbytes = static_cast<size_t>(end - begin);
+        const char * range = backend_->data(begin, nbytes);
+        trace_data_type buffer;
+        if (range == nullptr) {
+            buffer.resize(nbytes);
+            backend_->read(begin, buffer.data(), nbytes);
+            range = buffer.data();
+        }
+        // Decode each trace in place
+        for (size_t ii = 0; ii < count; ++ii) {
+            auto nSamples = indexer_->nsamples(first + ii);
+            auto trace = range + (indexer_->position(first + ii) - begin);
+            TraceView view(trace, nSamples, encoding_format);
+            view.copyTo(samples + ii * stride);
+            std::fill(samples + ii * stride + nSamples, samples + (ii + 1) * stride, T());
+            if (headers != nullptr) {
+                std::copy(trace, trace + TraceHeader::buffer_size, headers + ii * TraceHeader::buffer_size);
             }
         }
-        return trace;
-        //////////
     }
 
-    template Trace<float> SegyFile::readTraceAs<float> (const size_t n);
-    template Trace<int32_t> SegyFile::readTraceAs<int32_t>(const size_t n);
-    template Trace<int16_t> SegyFile::readTraceAs<int16_t>(const size_t n);
-    template Trace<int8_t> SegyFile::readTraceAs<int8_t> (const size_t n);
+    template void SegyFile::readTracesAs<float >(const size_t first, const size_t count, float * samples, const size_t stride, char * headers);
+    template void SegyFile::readTracesAs<int32_t>(const size_t first, const size_t count, int32_t * samples, const size_t stride, char * headers);
+    template void SegyFile::readTracesAs<int16_t>(const size_t first, const size_t count, int16_t * samples, const size_t stride, char * headers);
+    template void SegyFile::readTracesAs<int8_t >(const size_t first, const size_t count, int8_t * samples, const size_t stride, char * headers);
 
     template<class T>
-    void SegyFile::appendTrace(const Trace<T>& trace) {        
-        appendRawTrace(convertToRawType(trace));        
+    void SegyFile::appendTrace(const Trace<T>& trace) {
+        auto encoding_format = (*bfh_)[rev0::bfh::formatCode];
+        // Check consistency
+        checkConsistencyWithType<T>();
+        // Encode trace data directly in the append queue
+        auto samples = reinterpret_cast<const char *> (trace.data());
+        auto data = writer_->appendSlot(trace, trace.size() * sizeof (T), sizeof (T));
+        if (encoding_format == constants::SegyFileFormatCode::IBMfloat32) {
+            // Convert IEEE754 to IBMfloat32, swapping bytes in the same pass
+            ieee2ibm(samples, data, trace.size(), littleEndianHost);
+        } else if (littleEndianHost) {
+            swapByteOrder(samples, data, trace.size(), sizeof (T));
+        } else {
+            copy(samples, samples + trace.size() * sizeof (T), data);
+        }
     }
 
     template void SegyFile::appendTrace<float >(const Trace<float >& trace);
@@ -187,6 +583,97 @@ namespace seismic {
     template void SegyFile::overwriteTrace<int16_t>(const Trace<int16_t>& trace, const size_t n);
     template void SegyFile::overwriteTrace<int8_t >(const Trace<int8_t >& trace, const size_t n);
 
+    namespace {
+        /// Checks that a value lies on an axis of the lattice
+        void checkOnAxis(const RegularGridHeaderIndex::Axis& axis, const int32_t value, const char * name, const path& filePath) {
+            auto distance = static_cast<int64_t>(value) - axis.min;
+            if (value < axis.min || value > axis.max || (axis.stride != 0 && distance % axis.stride != 0)) {
+                stringstream estream;
+                estream << "Trying to read " << name << " " << value << ", which is not on the lattice" << endl;
+                estream << "\tSEG-Y file : " << filePath << endl;
+                estream << "\trange      : [" << axis.min << ", " << axis.max << "] with stride " << axis.stride << endl;
+                throw out_of_range(estream.str());
+            }
+        }
+        
+        /// Reads whole traces into the cells of an output buffer
+        template<class T>
+        void readSegmentsAs(SegyFile& segyFile, const vector<RegularGridHeaderIndex::Segment>& segments, T * samples, const size_t stride) {
+            for (const auto& x : segments) {
+                if (x.count == 1 || x.step == 1) {
+                    // Consecutive traces fill consecutive cells: a single read
+                    segyFile.readTracesAs(x.trace, x.count, samples + x.cell * stride, stride);
+                    continue;
+                }
+                for (size_t k = 0; k < x.count; ++k) {
+                    auto cell = static_cast<ptrdiff_t>(x.cell) + static_cast<ptrdiff_t>(k) * x.step;
+                    segyFile.readTracesAs(x.trace + k, 1, samples + cell * stride, stride);
+                }
+            }
+        }
+    }
+
+    template<class T>
+    void SegyFile::readInlineAs(const int32_t il, T * samples, const size_t stride) {
+        const auto& grid = geometry();
+        checkOnAxis(grid.first(), il, "inline", filePath_);
+        std::fill(samples, samples + grid.second().size() * stride, T());
+        readSegmentsAs(*this, grid.segmentsFirst(il), samples, stride);
+    }
+
+    template void SegyFile::readInlineAs<float >(const int32_t il, float * samples, const size_t stride);
+    template void SegyFile::readInlineAs<int32_t>(const int32_t il, int32_t * samples, const size_t stride);
+    template void SegyFile::readInlineAs<int16_t>(const int32_t il, int16_t * samples, const size_t stride);
+    template void SegyFile::readInlineAs<int8_t >(const int32_t il, int8_t * samples, const size_t stride);
+
+    template<class T>
+    void SegyFile::readCrosslineAs(const int32_t xl, T * samples, const size_t stride) {
+        const auto& grid = geometry();
+        checkOnAxis(grid.second(), xl, "crossline", filePath_);
+        std::fill(samples, samples + grid.first().size() * stride, T());
+        readSegmentsAs(*this, grid.segmentsSecond(xl), samples, stride);
+    }
+
+    template void SegyFile::readCrosslineAs<float >(const int32_t xl, float * samples, const size_t stride);
+    template void SegyFile::readCrosslineAs<int32_t>(const int32_t xl, int32_t * samples, const size_t stride);
+    template void SegyFile::readCrosslineAs<int16_t>(const int32_t xl, int16_t * samples, const size_t stride);
+    template void SegyFile::readCrosslineAs<int8_t >(const int32_t xl, int8_t * samples, const size_t stride);
+
+    template<class T>
+    void SegyFile::readTimeSliceAs(const size_t sample, T * values) {
+        const auto& grid = geometry();
+        checkConsistencyWithType<T>();
+        auto encoding_format = (*bfh_)[rev0::bfh::formatCode];
+        std::fill(values, values + grid.first().size() * grid.second().size(), T());
+        // Only the bytes of the requested sample are fetched from each trace
+        char bytes[sizeof (T)];
+        for (const auto& x : grid.segments()) {
+            for (size_t k = 0; k < x.count; ++k) {
+                auto n = x.trace + k;
+                if (sample >= indexer_->nsamples(n)) {
+                    continue;
+                }
+                auto position = indexer_->position(n) + static_cast<streamoff>(TraceHeader::buffer_size + sample * sizeof (T));
+                const char * data = backend_->data(position, sizeof (T));
+                if (data == nullptr) {
+                    backend_->read(position, bytes, sizeof (T));
+                    data = bytes;
+                }
+                auto& value = values[static_cast<ptrdiff_t>(x.cell) + static_cast<ptrdiff_t>(k) * x.step];
+                if (encoding_format == constants::SegyFileFormatCode::IBMfloat32) {
+                    ibm2ieee(data, reinterpret_cast<char *> (&value), 1, littleEndianHost);
+                } else {
+                    value = readBigEndian<T>(data);
+                }
+            }
+        }
+    }
+
+    template void SegyFile::readTimeSliceAs<float >(const size_t sample, float * values);
+    template void SegyFile::readTimeSliceAs<int32_t>(const size_t sample, int32_t * values);
+    template void SegyFile::readTimeSliceAs<int16_t>(const size_t sample, int16_t * values);
+    template void SegyFile::readTimeSliceAs<int8_t >(const size_t sample, int8_t * values);
+
     ////////////////////
     // Private functions
     ////////////////////
@@ -241,6 +728,11 @@ namespace seismic {
         //////////        
     }
 
+    template void SegyFile::checkConsistencyWithType<float >();
+    template void SegyFile::checkConsistencyWithType<int32_t>();
+    template void SegyFile::checkConsistencyWithType<int16_t>();
+    template void SegyFile::checkConsistencyWithType<int8_t >();
+
     template<class T>
     SegyFile::raw_trace_type SegyFile::convertToRawType(const Trace<T>& trace) {
         auto encoding_format = (*bfh_)[rev0::bfh::formatCode];
@@ -249,18 +741,14 @@ namespace seismic {
         // Convert to a char stream
         std::vector<char> raw_stream;
         raw_stream.resize(trace.size() * sizeof (typename Trace<T>::value_type));
-        std::copy(reinterpret_cast<const char *> (trace.data()),
-                reinterpret_cast<const char *> (trace.data() + trace.size()),
-                raw_stream.begin()
-                );
-        // Convert IBMfloat32 to IEEE754
         if (encoding_format == constants::SegyFileFormatCode::IBMfloat32) {
-            for_each(reinterpret_cast<int32_t*> (raw_stream.data()),
-                    reinterpret_cast<int32_t*> (raw_stream.data() + raw_stream.size()),
-                    [](int32_t & x) {
-                        ieee2ibm(x);
-                    }
-            );
+            // Convert IEEE754 to IBMfloat32 while copying
+            ieee2ibm(reinterpret_cast<const char *> (trace.data()), raw_stream.data(), trace.size(), false);
+        } else {
+            std::copy(reinterpret_cast<const char *> (trace.data()),
+                    reinterpret_cast<const char *> (trace.data() + trace.size()),
+                    raw_stream.begin()
+                    );
         }
         return make_pair(static_cast<const TraceHeader::smart_reference_type&> (trace), std::move(raw_stream));
     }
@@ -0,0 +1,190 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include<impl/SegyFile-HeaderColumns.h>
+
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/utilities-inl.h>
+
+#include<boost/filesystem/fstream.hpp>
+
+#include<algorithm>
+#include<sstream>
+#include<stdexcept>
+
+using namespace std;
+
+namespace seismic {
+    
+    HeaderColumns::HeaderColumns() : m_size(0) {
+    }
+    
+    size_t HeaderColumns::ncolumns() const {
+        return m_columns.size();
+    }
+    
+    size_t HeaderColumns::size() const {
+        return m_size;
+    }
+    
+    const HeaderColumns::column_type& HeaderColumns::column(const size_t ii) const {
+        return m_columns.at(ii);
+    }
+    
+    HeaderColumns::column_type& HeaderColumns::column(const size_t ii) {
+        return m_columns.at(ii);
+    }
+    
+    const std::vector<uint64_t>& HeaderColumns::checksums() const {
+        return m_checksums;
+    }
+    
+    void HeaderColumns::push_back(const char * header) {
+        for (size_t ii = 0; ii < m_fields.size(); ++ii) {
+            auto field = header + m_fields[ii].offset;
+            m_columns[ii].push_back( m_fields[ii].size == 4 ? readBigEndian<int32_t>(field) : readBigEndian<int16_t>(field) );
+        }
+        if ( m_size % checksum_block == 0 ) {
+            m_checksums.push_back(IndexSignature::checksum(nullptr, 0));
+        }
+        m_checksums.back() = IndexSignature::checksum(header, TraceHeader::buffer_size, m_checksums.back());
+        ++m_size;
+    }
+    
+    void HeaderColumns::store(const size_t n, char * header) const {
+        for (size_t ii = 0; ii < m_fields.size(); ++ii) {
+            auto field = header + m_fields[ii].offset;
+            auto value = m_columns[ii][n];
+            if ( m_fields[ii].size == 4 ) {
+                writeBigEndian(value, field);
+            } else {
+                writeBigEndian(static_cast<int16_t>(value), field);
+            }
+        }
+    }
+    
+    void HeaderColumns::resize(const size_t ntraces) {
+        for (auto& x : m_columns) {
+            x.resize(ntraces);
+        }
+        m_size = ntraces;
+        m_checksums.clear();
+    }
+    
+    void HeaderColumns::clear() {
+        for (auto& x : m_columns) {
+            x.clear();
+        }
+        m_size = 0;
+        m_checksums.clear();
+    }
+    
+    void HeaderColumns::save(const boost::filesystem::path& path, const IndexSignature& signature) const {
+        boost::filesystem::ofstream out(path, ios::binary | ios::trunc);
+        out.exceptions(ios::badbit | ios::failbit);
+        IndexSignature stamped(signature);
+        stamped.magic = magic_number;
+        stamped.version = current_version;
+        uint64_t ncols(m_fields.size());
+        uint64_t ntraces(m_size);
+        out.write(reinterpret_cast<const char *> (&stamped), sizeof (stamped));
+        out.write(reinterpret_cast<const char *> (&ncols), sizeof (ncols));
+        out.write(reinterpret_cast<const char *> (&ntraces), sizeof (ntraces));
+        out.write(reinterpret_cast<const char *> (m_fields.data()), m_fields.size() * sizeof (Component));
+        for (const auto& x : m_columns) {
+            out.write(reinterpret_cast<const char *> (x.data()), x.size() * sizeof (int32_t));
+        }
+        uint64_t nchecksums(m_checksums.size());
+        out.write(reinterpret_cast<const char *> (&nchecksums), sizeof (nchecksums));
+        out.write(reinterpret_cast<const char *> (m_checksums.data()), m_checksums.size() * sizeof (uint64_t));
+    }
+    
+    bool HeaderColumns::load(const boost::filesystem::path& path, IndexSignature& signature) {
+        if ( !exists(path) ) {
+            return false;
+        }
+        boost::filesystem::ifstream in(path, ios::binary);
+        IndexSignature stored;
+        uint64_t ncols(0);
+        uint64_t ntraces(0);
+        in.read(reinterpret_cast<char *> (&stored), sizeof (stored));
+        in.read(reinterpret_cast<char *> (&ncols), sizeof (ncols));
+        in.read(reinterpret_cast<char *> (&ntraces), sizeof (ntraces));
+        if ( !in || stored.magic != magic_number || stored.version != current_version || ncols != m_fields.size() ) {
+            return false;
+        }
+        vector<Component> fields(ncols);
+        in.read(reinterpret_cast<char *> (fields.data()), fields.size() * sizeof (Component));
+        if ( !in || fields != m_fields ) {
+            return false;
+        }
+        // Counts are untrusted: they must fit the bytes actually stored in the cache
+        uint64_t available = file_size(path) - static_cast<uint64_t>(in.tellg());
+        if ( ncols != 0 && ntraces > available / (ncols * sizeof (int32_t)) ) {
+            return false;
+        }
+        vector<column_type> columns(ncols, column_type(ntraces));
+        for (auto& x : columns) {
+            in.read(reinterpret_cast<char *> (x.data()), x.size() * sizeof (int32_t));
+        }
+        uint64_t nchecksums(0);
+        in.read(reinterpret_cast<char *> (&nchecksums), sizeof (nchecksums));
+        if ( !in || ( nchecksums != 0 && nchecksums != (ntraces + checksum_block - 1) / checksum_block ) ||
+                nchecksums > ( file_size(path) - static_cast<uint64_t>(in.tellg()) ) / sizeof (uint64_t) ) {
+            return false;
+        }
+        vector<uint64_t> checksums(nchecksums);
+        in.read(reinterpret_cast<char *> (checksums.data()), checksums.size() * sizeof (uint64_t));
+        if ( !in ) {
+            return false;
+        }
+        m_columns.swap(columns);
+        m_checksums.swap(checksums);
+        m_size = ntraces;
+        signature = stored;
+        return true;
+    }
+    
+    size_t HeaderColumns::add(const Component& component) {
+        auto it = std::find(m_fields.begin(), m_fields.end(), component);
+        if ( it != m_fields.end() ) {
+            return it - m_fields.begin();
+        }
+        clear();
+        m_fields.push_back(component);
+        m_columns.push_back(column_type());
+        return m_fields.size() - 1;
+    }
+    
+    size_t HeaderColumns::find(const Component& component) const {
+        auto it = std::find(m_fields.begin(), m_fields.end(), component);
+        if ( it == m_fields.end() ) {
+            stringstream estream;
+            estream << "Header columns error : no column holds the field at byte " << component.offset << endl;
+            throw out_of_range(estream.str());
+        }
+        return it - m_fields.begin();
+    }
+    
+    bool HeaderColumns::contains(const Component& component) const {
+        return std::find(m_fields.begin(), m_fields.end(), component) != m_fields.end();
+    }
+    
+}
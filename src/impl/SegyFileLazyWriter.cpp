@@ -21,74 +21,388 @@
 
 #include <impl/SegyFileLazyWriter.h>
 #include <impl/SegyFileIndexer.h>
+#include <impl/indexer/HeaderIndex.h>
 
-#include <iterator>
+#include <algorithm>
 #include <sstream>
 
 namespace seismic {
 
-SegyFileLazyWriter::SegyFileLazyWriter(SegyFileIndexer& indexer, boost::filesystem::fstream& fileStream)
-: indexer_(indexer), fileStream_(fileStream)
+namespace
+{
+/// Alignment of the end of the chunks written by background flushes
+const size_t chunk_alignment=4096;
+
+/// Largest write issued for a run of overwritten traces
+const size_t max_run_size=1 << 22;
+
+/// Largest gap between two overwritten headers that is rewritten, rather than skipped
+const std::streamoff max_skipped_bytes=4096;
+
+/// Largest trace that can be queued (65535 samples of 4 bytes)
+const size_t max_trace_size=TraceHeader::buffer_size + 65535 * 4;
+
+/// Gives a queue exactly the requested capacity (reserve alone never shrinks it)
+void reserveExactly(std::vector<char>& bytes, size_t capacity)
+{
+  std::vector<char> reserved;
+  reserved.reserve(std::max(capacity, bytes.size()));
+  reserved.assign(bytes.begin(), bytes.end());
+  bytes.swap(reserved);
+}
+}
+
+SegyFileLazyWriter::SegyFileLazyWriter(SegyFileIndexer& indexer, boost::filesystem::fstream& fileStream, const boost::filesystem::path& filePath,
+                                       const ByteOrderPermutation<TraceHeader::buffer_size>& permutation)
+: indexer_(indexer), fileStream_(fileStream), filePath_(filePath), permutation_(permutation), memoryBudget_(0), flushed_(0), flushing_(false), stop_(false)
 {
 }
 
-void SegyFileLazyWriter::addToOverwriteQueue(const SegyFile::raw_trace_type& trace, size_t n)
+void SegyFileLazyWriter::encodeHeader(const TraceHeader::smart_reference_type& header, char * destination) const
 {
-  overwriteMap_[n]=trace;
+  // The header in memory is left untouched
+#ifdef LITTLE_ENDIAN
+  permutation_.apply(header.get(), destination);
+#else
+  std::copy(header.get(), header.get() + TraceHeader::buffer_size, destination);
+#endif
+}
+
+SegyFileLazyWriter::~SegyFileLazyWriter()
+{
+  if (flusher_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_=true;
+    }
+    cv_.notify_all();
+    flusher_.join();
+  }
+}
+
+void SegyFileLazyWriter::setMemoryBudget(size_t bytes)
+{
+  using namespace std;
+  unique_lock<mutex> lock(mutex_);
+  waitForFlush(lock);
+  memoryBudget_=bytes;
+  if (bytes == 0)
+  {
+    return;
+  }
+  // A queue is flushed once it holds half the budget, so it never outgrows
+  // half the budget plus one trace: allocate both queues upfront, so that 
+  // resizing them never doubles their capacity
+  auto capacity=bytes / 2 + max_trace_size;
+  reserveExactly(appendVector_, capacity);
+  reserveExactly(flushVector_, capacity);
+}
+
+void SegyFileLazyWriter::addToOverwriteQueue(const SegyFile::raw_trace_type& trace, size_t n, size_t sizeOfDataSample)
+{
+  // Encode the trace right away: the caller is free to reuse its header and data
+  auto& bytes=overwriteMap_[n];
+  bytes.resize(TraceHeader::buffer_size + trace.second.size());
+  encodeHeader(trace.first, bytes.data());
+#ifdef LITTLE_ENDIAN
+  swapByteOrder(trace.second.data(), bytes.data() + TraceHeader::buffer_size, trace.second.size() / sizeOfDataSample, sizeOfDataSample);
+#else
+  std::copy(trace.second.begin(), trace.second.end(), bytes.data() + TraceHeader::buffer_size);
+#endif
+  headerOverwriteMap_.erase(n);
+}
+
+void SegyFileLazyWriter::addToHeaderOverwriteQueue(const TraceHeader::smart_reference_type& header, size_t n)
+{
+  auto x=overwriteMap_.find(n);
+  if (x != overwriteMap_.end())
+  {
+    encodeHeader(header, x->second.data());
+  }
+  else
+  {
+    encodeHeader(header, headerOverwriteMap_[n].data());
+  }
+}
+
+char * SegyFileLazyWriter::headerOverwriteSlot(size_t n, const char * header)
+{
+  auto x=overwriteMap_.find(n);
+  if (x != overwriteMap_.end())
+  {
+    return x->second.data();
+  }
+  auto inserted=headerOverwriteMap_.insert(std::make_pair(n, std::array<char, TraceHeader::buffer_size>()));
+  auto bytes=inserted.first->second.data();
+  if (inserted.second)
+  {
+    std::copy(header, header + TraceHeader::buffer_size, bytes);
+  }
+  return bytes;
 }
 
 void SegyFileLazyWriter::commit(size_t sizeOfDataSample)
 {
   using namespace std;
-  // Commit overwrite modifications
-  for (auto& x : overwriteMap_)
+  // Wait for the chunk being flushed
+  {
+    unique_lock<mutex> lock(mutex_);
+    waitForFlush(lock);
+  }
+  // Check consistency of every trace, before writing any of them
+  for (const auto& x : overwriteMap_)
   {
     auto idx=x.first;
-    auto trace=x.second;
-    // Check consistency
-    if (static_cast<size_t> (trace.first[rev0::th::nsamplesTrace]) != indexer_.nsamples(idx))
+    const auto& trace=x.second;
+    auto nsamples=static_cast<uint16_t> (TraceHeaderView(trace.data())[rev0::th::nsamplesTrace]);
+    if (nsamples != indexer_.nsamples(idx))
     {
       stringstream estream;
       estream << "Trying to overwrite a trace with different number of samples" << endl;
       estream << "\texpected number : " << indexer_.nsamples(idx) << endl;
-      estream << "\tactually got    : " << static_cast<size_t> (trace.first[rev0::th::nsamplesTrace]) << endl;
+      estream << "\tactually got    : " << nsamples << endl;
       throw runtime_error(estream.str());
     }
-    if (trace.second.size() != indexer_.nsamples(idx) * sizeOfDataSample)
+    if (trace.size() - TraceHeader::buffer_size != indexer_.nsamples(idx) * sizeOfDataSample)
     {
       stringstream estream;
       estream << "Unexpected length of trace data" << endl;
-      estream << "\tnumber of samples : " << indexer_.nsamples(idx);
+      estream << "\tnumber of samples : " << indexer_.nsamples(idx) << endl;
       estream << "\texpected length   : " << indexer_.nsamples(idx) * sizeOfDataSample << endl;
-      estream << "\tactually got      : " << trace.second.size() << endl;
+      estream << "\tactually got      : " << trace.size() - TraceHeader::buffer_size << endl;
+      throw runtime_error(estream.str());
+    }
+  }
+  for (const auto& x : headerOverwriteMap_)
+  {
+    auto nsamples=static_cast<uint16_t> (TraceHeaderView(x.second.data())[rev0::th::nsamplesTrace]);
+    if (nsamples != indexer_.nsamples(x.first))
+    {
+      stringstream estream;
+      estream << "Trying to overwrite a trace header with different number of samples" << endl;
+      estream << "\texpected number : " << indexer_.nsamples(x.first) << endl;
+      estream << "\tactually got    : " << nsamples << endl;
       throw runtime_error(estream.str());
     }
-    // Overwrite trace
-    fileStream_.seekp(indexer_.position(idx));
-    write(fileStream_, trace.first);
-    write(fileStream_, trace.second, trace.first[rev0::th::nsamplesTrace], sizeOfDataSample);
+  }
+  // Commit overwrite modifications, with a single write for each run of traces adjacent in the file
+  auto x=overwriteMap_.begin();
+  while (x != overwriteMap_.end())
+  {
+    auto first=x;
+    auto begin=indexer_.position(x->first);
+    auto end=begin;
+    overwriteVector_.clear();
+    while (x != overwriteMap_.end() && indexer_.position(x->first) == end && overwriteVector_.size() < max_run_size)
+    {
+      const auto& trace=x->second;
+      overwriteVector_.insert(overwriteVector_.end(), trace.begin(), trace.end());
+      end+=static_cast<streamoff> (trace.size());
+      ++x;
+    }
+    fileStream_.seekp(begin);
+    fileStream_.write(overwriteVector_.data(), overwriteVector_.size());
+    // Keep secondary indexes in sync with the new headers
+    for (; first != x; ++first)
+    {
+      for (auto& index : indexer_.header_indexes())
+      {
+        if (first->first < index->size())
+        {
+          index->insert(first->first, first->second.data());
+        }
+      }
+    }
   }
   overwriteMap_.clear();
-  // Commit append modifications
-  fileStream_.seekp(0, ios::end);
+  // Commit header-only modifications, leaving trace data untouched. Headers 
+  // close to each other are patched in a run read back from the file, and 
+  // written at once
+  auto y=headerOverwriteMap_.begin();
+  while (y != headerOverwriteMap_.end())
+  {
+    auto first=y;
+    auto begin=indexer_.position(y->first);
+    auto end=begin + static_cast<streamoff> (TraceHeader::buffer_size);
+    for (++y; y != headerOverwriteMap_.end(); ++y)
+    {
+      auto position=indexer_.position(y->first);
+      if (position < end || position - end > max_skipped_bytes || position - begin + static_cast<streamoff> (TraceHeader::buffer_size) > static_cast<streamoff> (max_run_size))
+      {
+        break;
+      }
+      end=position + static_cast<streamoff> (TraceHeader::buffer_size);
+    }
+    overwriteVector_.resize(static_cast<size_t> (end - begin));
+    if (next(first) != y)
+    {
+      fileStream_.seekg(begin);
+      fileStream_.read(overwriteVector_.data(), overwriteVector_.size());
+    }
+    for (; first != y; ++first)
+    {
+      auto header=overwriteVector_.data() + (indexer_.position(first->first) - begin);
+      copy(first->second.begin(), first->second.end(), header);
+      // Keep secondary indexes in sync with the new headers
+      for (auto& index : indexer_.header_indexes())
+      {
+        if (first->first < index->size())
+        {
+          index->insert(first->first, header);
+        }
+      }
+    }
+    fileStream_.seekp(begin);
+    fileStream_.write(overwriteVector_.data(), overwriteVector_.size());
+  }
+  headerOverwriteMap_.clear();
+  // Commit append modifications, after the chunks already flushed
+  if (flushed_ > 0)
+  {
+    fileStream_.seekp(appendBase_ + static_cast<streamoff> (flushed_));
+    flushed_=0;
+  }
+  else
+  {
+    fileStream_.seekp(0, ios::end);
+    appendBase_=fileStream_.tellp();
+  }
   fileStream_.write(appendVector_.data(), appendVector_.size());
   appendVector_.clear();
-  // Update index
-  indexer_.update_index();
+  // Update index with the entries of the appended traces, instead of reading them back
+  for (auto& x : appendEntries_)
+  {
+    x=IndexItem(appendBase_ + static_cast<streamoff> (x.position()), x.nsamples());
+  }
+  indexer_.append_entries(appendEntries_);
+  appendEntries_.clear();
 }
 
 void SegyFileLazyWriter::addToAppendQueue(const SegyFile::raw_trace_type& trace, size_t sizeOfDataSample)
+{
+  auto data=appendSlot(trace.first, trace.second.size(), sizeOfDataSample);
+  // Encode trace data directly in the queue
+#ifdef LITTLE_ENDIAN
+  swapByteOrder(trace.second.data(), data, trace.second.size() / sizeOfDataSample, sizeOfDataSample);
+#else
+  std::copy(trace.second.begin(), trace.second.end(), data);
+#endif
+}
+
+char * SegyFileLazyWriter::appendSlot(TraceHeader::smart_reference_type header, size_t size, size_t sizeOfDataSample)
+{
+  using namespace std;
+  // Check consistency
+  auto nsamples=static_cast<uint16_t> (header[rev0::th::nsamplesTrace]);
+  if (size != nsamples * sizeOfDataSample)
+  {
+    stringstream estream;
+    estream << "Unexpected length of trace data" << endl;
+    estream << "\tnumber of samples : " << nsamples << endl;
+    estream << "\texpected length   : " << nsamples * sizeOfDataSample << endl;
+    estream << "\tactually got      : " << size << endl;
+    throw runtime_error(estream.str());
+  }
+  // Keep the queue within the memory budget
+  if (memoryBudget_ > 0 && appendVector_.size() >= memoryBudget_ / 2)
+  {
+    flushAppendQueue();
+  }
+  // The capacity of the queue survives commits
+  auto offset=appendVector_.size();
+  appendEntries_.emplace_back(static_cast<streamoff> (flushed_ + offset), nsamples);
+  appendVector_.resize(offset + TraceHeader::buffer_size + size);
+  auto bytes=appendVector_.data() + offset;
+  encodeHeader(header, bytes);
+  return bytes + TraceHeader::buffer_size;
+}
+
+void SegyFileLazyWriter::flushAppendQueue()
+{
+  using namespace std;
+  unique_lock<mutex> lock(mutex_);
+  waitForFlush(lock);
+  if (flushed_ == 0)
+  {
+    // First chunk since the last commit: appended bytes start at the end of the file
+    fileStream_.flush();
+    fileStream_.seekp(0, ios::end);
+    appendBase_=fileStream_.tellp();
+    if (!flushStream_.is_open())
+    {
+      flushStream_.open(filePath_, ios::binary | ios::in | ios::out);
+      flushStream_.exceptions(ios::badbit | ios::failbit);
+    }
+  }
+  // End the chunk on an aligned position, and carry the rest over
+  auto begin=static_cast<size_t> (static_cast<streamoff> (appendBase_)) + flushed_;
+  auto end=begin + appendVector_.size();
+  auto length=end - end % chunk_alignment > begin ? end - end % chunk_alignment - begin : appendVector_.size();
+  flushVector_.assign(appendVector_.begin() + length, appendVector_.end());
+  appendVector_.resize(length);
+  swap(appendVector_, flushVector_);
+  flushPosition_=appendBase_ + static_cast<streamoff> (flushed_);
+  flushed_+=length;
+  flushing_=true;
+  if (!flusher_.joinable())
+  {
+    flusher_=thread(&SegyFileLazyWriter::flushLoop, this);
+  }
+  lock.unlock();
+  cv_.notify_all();
+}
+
+void SegyFileLazyWriter::waitForFlush(std::unique_lock<std::mutex>& lock)
+{
+  using namespace std;
+  cv_.wait(lock, [this]()
+  {
+    return !flushing_;
+  });
+  if (error_)
+  {
+    auto error=error_;
+    error_=nullptr;
+    rethrow_exception(error);
+  }
+}
+
+void SegyFileLazyWriter::flushLoop()
 {
   using namespace std;
-  // Declare a stream of byte
-  stringstream byte_stream;
-  // Write trace header
-  write(byte_stream, trace.first);
-  // Write trace data
-  trace_data_type traceDataCopy(trace.second);
-  write(byte_stream, traceDataCopy, trace.first[rev0::th::nsamplesTrace], sizeOfDataSample);
-  // Append to internal buffer
-  auto buffer=byte_stream.str();
-  copy(buffer.begin(), buffer.end(), back_inserter(appendVector_));
+  while (true)
+  {
+    {
+      unique_lock<mutex> lock(mutex_);
+      cv_.wait(lock, [this]()
+      {
+        return stop_ || flushing_;
+      });
+      if (!flushing_)
+      {
+        return;
+      }
+    }
+    // The chunk is not touched by the producer while being flushed
+    exception_ptr error;
+    try
+    {
+      flushStream_.seekp(flushPosition_);
+      flushStream_.write(flushVector_.data(), flushVector_.size());
+      flushStream_.flush();
+    }
+    catch (...)
+    {
+      error=current_exception();
+    }
+    {
+      lock_guard<mutex> lock(mutex_);
+      flushVector_.clear();
+      flushing_=false;
+      error_=error;
+    }
+    cv_.notify_all();
+  }
 }
 }
@@ -0,0 +1,189 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/SegyStreamReader.h>
+
+#include<impl/SegyFileIndexer.h>
+#include<impl/rev0/SegyFile-BinaryFileHeader-Rev0.h>
+#include<impl/utilities-inl.h>
+
+#include<algorithm>
+#include<cstring>
+#include<sstream>
+#include<stdexcept>
+
+using namespace std;
+
+namespace seismic {
+    
+    constexpr size_t SegyStreamReader::default_buffer_size;
+    
+    SegyStreamReader::SegyStreamReader(SegyFile& segyFile, const size_t first, const size_t bufferSize) 
+    : segyFile_(segyFile)
+    , sizeOfDataSample_(constants::sizeOfDataSample(segyFile.getBinaryFileHeader()[rev0::bfh::formatCode]))
+    , stream_(segyFile.path(), ios::binary | ios::in)
+    , holding_(false), next_(0), offset_(0), position_(std::min(first, segyFile.ntraces()))
+    , done_(false), stop_(false) {
+        if (!stream_) {
+            stringstream estream;
+            estream << "Stream error : can't open SEG-Y file for sequential reads" << endl;
+            estream << "\tSEG-Y file : " << segyFile.path() << endl;
+            throw runtime_error(estream.str());
+        }
+        // Group traces that are contiguous in the file into extents
+        auto& indexer = *segyFile.indexer_;
+        for (size_t ii = first; ii < segyFile.ntraces(); ++ii) {
+            auto position = indexer.position(ii);
+            auto size = TraceHeader::buffer_size + indexer.nsamples(ii) * sizeOfDataSample_;
+            if (!extents_.empty()) {
+                auto& extent = extents_.back();
+                if (extent.begin + static_cast<streamoff>(extent.size) == position && extent.size + size <= bufferSize) {
+                    ++extent.count;
+                    extent.size += size;
+                    continue;
+                }
+            }
+            extents_.push_back(Extent{ii, 1, position, size});
+        }
+        // Two buffers: one is decoded while the other is filled
+        spare_.resize(2);
+        producer_ = thread(&SegyStreamReader::prefetch, this);
+    }
+    
+    SegyStreamReader::~SegyStreamReader() {
+        {
+            lock_guard<mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        producer_.join();
+    }
+    
+    template<class T>
+    bool SegyStreamReader::next(Trace<T>& trace) {
+        segyFile_.checkConsistencyWithType<T>();
+        if ((!holding_ || next_ == extents_[current_.extent].count) && !fetch()) {
+            return false;
+        }
+        auto n = extents_[current_.extent].first + next_;
+        const char * bytes = current_.bytes.data() + offset_;
+        TraceHeader::smart_reference_type& header = trace;
+        if (!header) {
+            header = TraceHeader::smart_reference_type(segyFile_.thPrototype_->create());
+        }
+        // Decode trace header
+        segyFile_.decodeTraceHeader(bytes, trace.get());
+        // Decode trace data
+        trace.resize(segyFile_.indexer_->nsamples(n));
+        bytes += TraceHeader::buffer_size;
+        if (segyFile_.getBinaryFileHeader()[rev0::bfh::formatCode] == constants::SegyFileFormatCode::IBMfloat32) {
+            ibm2ieee(bytes, reinterpret_cast<char *> (trace.data()), trace.size(), littleEndianHost);
+        } else {
+#ifdef LITTLE_ENDIAN
+            swapByteOrder(bytes, reinterpret_cast<char *> (trace.data()), trace.size(), sizeof (T));
+#else
+            memcpy(trace.data(), bytes, trace.size() * sizeof (T));
+#endif
+        }
+        ++next_;
+        position_ = n + 1;
+        offset_ += TraceHeader::buffer_size + trace.size() * sizeof (T);
+        return true;
+    }
+    
+    template bool SegyStreamReader::next<float >(Trace<float >& trace);
+    template bool SegyStreamReader::next<int32_t>(Trace<int32_t>& trace);
+    template bool SegyStreamReader::next<int16_t>(Trace<int16_t>& trace);
+    template bool SegyStreamReader::next<int8_t >(Trace<int8_t >& trace);
+    
+    size_t SegyStreamReader::position() const {
+        return position_;
+    }
+    
+    bool SegyStreamReader::fetch() {
+        unique_lock<mutex> lock(mutex_);
+        if (holding_) {
+            spare_.push_back(move(current_));
+            holding_ = false;
+            cv_.notify_all();
+        }
+        cv_.wait(lock, [this]() {
+            return !ready_.empty() || done_;
+        });
+        if (ready_.empty()) {
+            if (error_) {
+                rethrow_exception(error_);
+            }
+            return false;
+        }
+        current_ = move(ready_.front());
+        ready_.pop_front();
+        holding_ = true;
+        next_ = 0;
+        offset_ = 0;
+        return true;
+    }
+    
+    void SegyStreamReader::prefetch() {
+        try {
+            for (size_t ii = 0; ii < extents_.size(); ++ii) {
+                Chunk chunk;
+                {
+                    unique_lock<mutex> lock(mutex_);
+                    cv_.wait(lock, [this]() {
+                        return stop_ || !spare_.empty();
+                    });
+                    if (stop_) {
+                        return;
+                    }
+                    chunk = move(spare_.back());
+                    spare_.pop_back();
+                }
+                // Fetch the whole extent with a single read, outside the lock
+                auto& extent = extents_[ii];
+                chunk.extent = ii;
+                chunk.bytes.resize(extent.size);
+                stream_.seekg(extent.begin);
+                stream_.read(chunk.bytes.data(), extent.size);
+                if (!stream_) {
+                    stringstream estream;
+                    estream << "Stream error : can't read traces [" << extent.first << ", " << extent.first + extent.count << ")" << endl;
+                    estream << "\tSEG-Y file : " << segyFile_.path() << endl;
+                    throw runtime_error(estream.str());
+                }
+                {
+                    lock_guard<mutex> lock(mutex_);
+                    ready_.push_back(move(chunk));
+                }
+                cv_.notify_all();
+            }
+        } catch (...) {
+            lock_guard<mutex> lock(mutex_);
+            error_ = current_exception();
+        }
+        {
+            lock_guard<mutex> lock(mutex_);
+            done_ = true;
+        }
+        cv_.notify_all();
+    }
+    
+}
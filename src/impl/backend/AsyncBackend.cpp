@@ -0,0 +1,470 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/backend/AsyncBackend.h>
+
+#include<SegyFile.h>
+
+#include<algorithm>
+#include<cerrno>
+#include<condition_variable>
+#include<cstring>
+#include<deque>
+#include<mutex>
+#include<sstream>
+#include<stdexcept>
+#include<thread>
+#include<vector>
+
+#include<fcntl.h>
+#include<sys/uio.h>
+#include<unistd.h>
+
+#ifdef HAVE_IO_URING
+#include<linux/io_uring.h>
+#include<sys/mman.h>
+#include<sys/syscall.h>
+#endif
+
+using namespace std;
+
+namespace seismic {
+    
+    namespace {
+        
+        /// Minimum number of threads issuing positional reads
+        const unsigned min_workers = 4;
+        
+        /// A read in flight
+        struct Request {
+            off_t offset;
+            char * buffer;
+            size_t size;
+            size_t nread;
+            iovec remaining;
+            SegyFileBackend::completion_type completion;
+        };
+        
+        /// Builds the error reported when a read fails (error == 0 means an unexpected end of file)
+        exception_ptr readError(const boost::filesystem::path& path, const off_t offset, const size_t size, const int error) {
+            stringstream estream;
+            estream << "FATAL ERROR: positional read failed on " << path << endl;
+            estream << "\trequested : [" << offset << ", " << offset + size << ")" << endl;
+            estream << "\t" << ( error != 0 ? strerror(error) : "unexpected end of file" ) << endl;
+            return make_exception_ptr(runtime_error(estream.str()));
+        }
+        
+        /// Reads a range of bytes with positional reads, returns the error that occurred (if any)
+        exception_ptr readAll(const int fd, const boost::filesystem::path& path, const off_t offset, char * buffer, const size_t size) {
+            size_t nread(0);
+            while ( nread < size ) {
+                auto count = ::pread(fd, buffer + nread, size - nread, offset + nread);
+                if ( count < 0 && errno == EINTR ) {
+                    continue;
+                } else if ( count <= 0 ) {
+                    return readError(path, offset, size, count < 0 ? errno : 0);
+                }
+                nread += count;
+            }
+            return exception_ptr();
+        }
+        
+    }
+    
+    class AsyncBackend::Engine {
+    public:
+        /// Starts serving a request
+        virtual void submit(unique_ptr<Request> request) = 0;
+        
+        virtual bool usesIoUring() const = 0;
+        
+        virtual ~Engine() {
+        }
+    };
+    
+    namespace {
+        
+        /**
+         * @brief Serves reads with a pool of threads issuing positional reads
+         */
+        class ThreadPoolEngine : public AsyncBackend::Engine {
+        public:
+            ThreadPoolEngine(const int fd, const boost::filesystem::path& path) : m_fd(fd), m_path(path), m_stop(false) {
+                auto nworkers = max(min_workers, thread::hardware_concurrency());
+                for (unsigned ii = 0; ii < nworkers; ++ii) {
+                    m_workers.emplace_back(&ThreadPoolEngine::work, this);
+                }
+            }
+            
+            void submit(unique_ptr<Request> request) override {
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_queue.push_back(move(request));
+                }
+                m_cv.notify_one();
+            }
+            
+            bool usesIoUring() const override {
+                return false;
+            }
+            
+            ~ThreadPoolEngine() {
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_cv.notify_all();
+                for (auto& worker : m_workers) {
+                    worker.join();
+                }
+            }
+            
+        private:
+            void work() {
+                while (true) {
+                    unique_ptr<Request> request;
+                    {
+                        unique_lock<mutex> lock(m_mutex);
+                        m_cv.wait(lock, [this]() {
+                            return m_stop || !m_queue.empty();
+                        });
+                        // Drain the queue before stopping
+                        if (m_queue.empty()) {
+                            return;
+                        }
+                        request = move(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    request->completion(readAll(m_fd, m_path, request->offset, request->buffer, request->size));
+                }
+            }
+            
+            int m_fd;
+            boost::filesystem::path m_path;
+            mutex m_mutex;
+            condition_variable m_cv;
+            deque< unique_ptr<Request> > m_queue;
+            bool m_stop;
+            vector<thread> m_workers;
+        };
+        
+#ifdef HAVE_IO_URING
+        
+        /// Maximum number of reads in flight through io_uring
+        const unsigned queue_depth = 64;
+        
+        /**
+         * @brief Serves reads through an io_uring instance
+         * 
+         * Submissions are serialized by a mutex, and completions are reaped 
+         * by a dedicated thread. The number of reads in flight never exceeds
+         * the size of the submission queue, so that the completion queue 
+         * can't overflow. Short reads are resubmitted for the remaining bytes.
+         */
+        class IoUringEngine : public AsyncBackend::Engine {
+        public:
+            IoUringEngine(const int fd, const boost::filesystem::path& path) 
+            : m_fd(fd), m_path(path), m_ring(-1), m_sq_ring(MAP_FAILED), m_cq_ring(MAP_FAILED), m_sqes(MAP_FAILED), m_inflight(0) {
+                io_uring_params params;
+                memset(&params, 0, sizeof (params));
+                m_ring = static_cast<int>( syscall(__NR_io_uring_setup, queue_depth, &params) );
+                if ( m_ring < 0 ) {
+                    fail("io_uring_setup");
+                }
+                m_entries = params.sq_entries;
+                m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+                m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+                if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+                    m_sq_ring_size = m_cq_ring_size = max(m_sq_ring_size, m_cq_ring_size);
+                }
+                m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+                if ( m_sq_ring == MAP_FAILED ) {
+                    fail("mmap");
+                }
+                if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+                    m_cq_ring = m_sq_ring;
+                } else {
+                    m_cq_ring = mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+                    if ( m_cq_ring == MAP_FAILED ) {
+                        fail("mmap");
+                    }
+                }
+                m_sqes_size = params.sq_entries * sizeof (io_uring_sqe);
+                m_sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES);
+                if ( m_sqes == MAP_FAILED ) {
+                    fail("mmap");
+                }
+                auto sq = static_cast<char *>(m_sq_ring);
+                m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                m_sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+                auto cq = static_cast<char *>(m_cq_ring);
+                m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                m_cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+                m_reaper = thread(&IoUringEngine::reap, this);
+            }
+            
+            void submit(unique_ptr<Request> request) override {
+                unique_lock<mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() {
+                    return m_inflight < m_entries;
+                });
+                // The ring refers to the request as soon as its entry is published
+                auto pending = request.release();
+                auto error = push(pending);
+                if ( error != 0 ) {
+                    // The entry has been taken back: the request is ours again
+                    unique_ptr<Request> failed(pending);
+                    lock.unlock();
+                    failed->completion(readError(m_path, failed->offset, failed->size, error));
+                    return;
+                }
+                ++m_inflight;
+            }
+            
+            bool usesIoUring() const override {
+                return true;
+            }
+            
+            ~IoUringEngine() {
+                if ( m_reaper.joinable() ) {
+                    unique_lock<mutex> lock(m_mutex);
+                    m_cv.wait(lock, [this]() {
+                        return m_inflight == 0;
+                    });
+                    // A no-op without request stops the reaper (nothing else is in flight, so retrying is safe)
+                    while ( push(nullptr) != 0 ) {
+                        this_thread::yield();
+                    }
+                    lock.unlock();
+                    m_reaper.join();
+                }
+                release();
+            }
+            
+        private:
+            /// Releases the resources acquired so far, and throws
+            void fail(const char * call) {
+                auto error = errno;
+                release();
+                stringstream estream;
+                estream << "Backend error : " << call << " failed while setting up io_uring" << endl;
+                estream << "\t" << strerror(error) << endl;
+                throw runtime_error(estream.str());
+            }
+            
+            void release() {
+                if ( m_sqes != MAP_FAILED ) {
+                    munmap(m_sqes, m_sqes_size);
+                }
+                if ( m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring ) {
+                    munmap(m_cq_ring, m_cq_ring_size);
+                }
+                if ( m_sq_ring != MAP_FAILED ) {
+                    munmap(m_sq_ring, m_sq_ring_size);
+                }
+                if ( m_ring >= 0 ) {
+                    ::close(m_ring);
+                }
+            }
+            
+            /**
+             * @brief Submits the read of the remaining bytes of a request (a 
+             * no-op if null), must be called with the lock held
+             * 
+             * @return 0 if the kernel consumed the entry, an errno value 
+             * otherwise (the entry is then withdrawn from the ring)
+             */
+            int push(Request * request) {
+                auto tail = *m_sq_tail;
+                auto index = tail & m_sq_mask;
+                auto& sqe = static_cast<io_uring_sqe *>(m_sqes)[index];
+                memset(&sqe, 0, sizeof (sqe));
+                if ( request != nullptr ) {
+                    request->remaining.iov_base = request->buffer + request->nread;
+                    request->remaining.iov_len = request->size - request->nread;
+                    sqe.opcode = IORING_OP_READV;
+                    sqe.fd = m_fd;
+                    sqe.off = request->offset + request->nread;
+                    sqe.addr = reinterpret_cast<uint64_t>(&request->remaining);
+                    sqe.len = 1;
+                } else {
+                    sqe.opcode = IORING_OP_NOP;
+                }
+                sqe.user_data = reinterpret_cast<uint64_t>(request);
+                m_sq_array[index] = index;
+                __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+                long submitted;
+                do {
+                    submitted = syscall(__NR_io_uring_enter, m_ring, 1, 0, 0, nullptr, 0);
+                } while ( submitted < 0 && errno == EINTR );
+                if ( submitted == 1 ) {
+                    return 0;
+                }
+                auto error = submitted < 0 ? errno : EAGAIN;
+                // Entries are consumed only by the call above (there is no 
+                // polling thread, and the reaper submits nothing), so the 
+                // unconsumed entry can be withdrawn
+                __atomic_store_n(m_sq_tail, tail, __ATOMIC_RELEASE);
+                return error;
+            }
+            
+            void reap() {
+                while (true) {
+                    auto head = *m_cq_head;
+                    if ( head == __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE) ) {
+                        syscall(__NR_io_uring_enter, m_ring, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        continue;
+                    }
+                    auto cqe = m_cqes[head & m_cq_mask];
+                    __atomic_store_n(m_cq_head, head + 1, __ATOMIC_RELEASE);
+                    auto request = reinterpret_cast<Request *>(cqe.user_data);
+                    if ( request == nullptr ) {
+                        return;
+                    }
+                    if ( cqe.res > 0 ) {
+                        request->nread += cqe.res;
+                    }
+                    exception_ptr error;
+                    if ( (cqe.res > 0 && request->nread < request->size) || cqe.res == -EINTR || cqe.res == -EAGAIN ) {
+                        int pushed;
+                        {
+                            lock_guard<mutex> lock(m_mutex);
+                            pushed = push(request);
+                        }
+                        if ( pushed == 0 ) {
+                            continue;
+                        }
+                        error = readError(m_path, request->offset, request->size, pushed);
+                    } else if ( cqe.res <= 0 ) {
+                        error = readError(m_path, request->offset, request->size, -cqe.res);
+                    }
+                    unique_ptr<Request> done(request);
+                    done->completion(error);
+                    {
+                        lock_guard<mutex> lock(m_mutex);
+                        --m_inflight;
+                    }
+                    m_cv.notify_all();
+                }
+            }
+            
+            int m_fd;
+            boost::filesystem::path m_path;
+            int m_ring;
+            unsigned m_entries;
+            void * m_sq_ring;
+            size_t m_sq_ring_size;
+            void * m_cq_ring;
+            size_t m_cq_ring_size;
+            void * m_sqes;
+            size_t m_sqes_size;
+            unsigned * m_sq_tail;
+            unsigned m_sq_mask;
+            unsigned * m_sq_array;
+            unsigned * m_cq_head;
+            unsigned * m_cq_tail;
+            unsigned m_cq_mask;
+            io_uring_cqe * m_cqes;
+            mutex m_mutex;
+            condition_variable m_cv;
+            unsigned m_inflight;
+            thread m_reaper;
+        };
+        
+#endif
+        
+        /// Creates the engine that serves asynchronous reads
+        unique_ptr<AsyncBackend::Engine> makeEngine(const int fd, const boost::filesystem::path& path) {
+#ifdef HAVE_IO_URING
+            try {
+                return unique_ptr<AsyncBackend::Engine>(new IoUringEngine(fd, path));
+            } catch (const runtime_error&) {
+                // io_uring may be disabled by the kernel or by a sandbox
+            }
+#endif
+            return unique_ptr<AsyncBackend::Engine>(new ThreadPoolEngine(fd, path));
+        }
+        
+    }
+    
+    AsyncBackend::AsyncBackend() : m_fd(-1) {
+    }
+    
+    void AsyncBackend::reset_segy_file(SegyFile& segyFile) {
+        close();
+        m_path = segyFile.path();
+        m_fd = ::open(m_path.c_str(), O_RDONLY);
+        if ( m_fd < 0 ) {
+            stringstream estream;
+            estream << "FATAL ERROR: can't open " << m_path << " for asynchronous reads" << endl;
+            estream << "\t" << strerror(errno) << endl;
+            throw runtime_error(estream.str());
+        }
+        m_engine = makeEngine(m_fd, m_path);
+    }
+    
+    void AsyncBackend::read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const {
+        auto error = readAll(m_fd, m_path, static_cast<off_t>( static_cast<streamoff>(position) ), buffer, size);
+        if ( error ) {
+            rethrow_exception(error);
+        }
+    }
+    
+    const char * AsyncBackend::data(const boost::filesystem::fstream::pos_type, const size_t) const {
+        return nullptr;
+    }
+    
+    void AsyncBackend::readAsync(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size, const completion_type& completion) const {
+        if ( size == 0 ) {
+            completion(exception_ptr());
+            return;
+        }
+        m_engine->submit(unique_ptr<Request>(new Request{static_cast<off_t>( static_cast<streamoff>(position) ), buffer, size, 0, iovec(), completion}));
+    }
+    
+    void AsyncBackend::update() {
+        // Positional reads always see the current content of the file
+    }
+    
+    bool AsyncBackend::usesIoUring() const {
+        return m_engine && m_engine->usesIoUring();
+    }
+    
+    AsyncBackend::~AsyncBackend() {
+        close();
+    }
+    
+    void AsyncBackend::close() {
+        // Wait for the reads in flight before closing the descriptor
+        m_engine.reset();
+        if ( m_fd >= 0 ) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+    
+    bool AsyncBackend::m_is_registered(
+    AsyncBackend::factory_type::getFactory()->registerType("Async",make_shared<AsyncBackend>())
+    );
+}
@@ -0,0 +1,70 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/backend/MemoryMappedBackend.h>
+
+#include<SegyFile.h>
+
+#include<cstring>
+#include<sstream>
+#include<stdexcept>
+
+using namespace std;
+using namespace boost::interprocess;
+
+namespace seismic {
+    
+    void MemoryMappedBackend::reset_segy_file(SegyFile& segyFile) {
+        m_path = segyFile.path();
+        update();
+    }
+    
+    void MemoryMappedBackend::read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const {
+        memcpy(buffer, data(position, size), size);
+    }
+    
+    const char * MemoryMappedBackend::data(const boost::filesystem::fstream::pos_type position, const size_t size) const {
+        auto offset = static_cast<size_t>( static_cast<streamoff>(position) );
+        checkRangeOrThrow(offset, size);
+        return static_cast<const char *>(m_region.get_address()) + offset;
+    }
+    
+    void MemoryMappedBackend::update() {
+        // Remap the whole file, as its size may have changed
+        m_region = mapped_region();
+        m_mapping = file_mapping(m_path.c_str(), read_only);
+        m_region = mapped_region(m_mapping, read_only);
+    }
+    
+    void MemoryMappedBackend::checkRangeOrThrow(const size_t offset, const size_t size) const {
+        if ( offset + size > m_region.get_size() ) {
+            stringstream estream;
+            estream << "FATAL ERROR: trying to read past the end of the mapping of " << m_path << endl;
+            estream << "\tmapping size : " << m_region.get_size() << endl;
+            estream << "\trequested    : [" << offset << ", " << offset + size << ")" << endl;
+            throw runtime_error(estream.str());
+        }
+    }
+    
+    bool MemoryMappedBackend::m_is_registered(
+    MemoryMappedBackend::factory_type::getFactory()->registerType("MemoryMapped",make_shared<MemoryMappedBackend>())
+    );
+}
@@ -0,0 +1,93 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/backend/PositionalBackend.h>
+
+#include<SegyFile.h>
+
+#include<cerrno>
+#include<cstring>
+#include<sstream>
+#include<stdexcept>
+
+#include<fcntl.h>
+#include<unistd.h>
+
+using namespace std;
+
+namespace seismic {
+    
+    PositionalBackend::PositionalBackend() : m_fd(-1) {
+    }
+    
+    void PositionalBackend::reset_segy_file(SegyFile& segyFile) {
+        close();
+        m_path = segyFile.path();
+        m_fd = ::open(m_path.c_str(), O_RDONLY);
+        if ( m_fd < 0 ) {
+            stringstream estream;
+            estream << "FATAL ERROR: can't open " << m_path << " for positional reads" << endl;
+            estream << "\t" << strerror(errno) << endl;
+            throw runtime_error(estream.str());
+        }
+    }
+    
+    void PositionalBackend::read(const boost::filesystem::fstream::pos_type position, char * buffer, const size_t size) const {
+        auto offset = static_cast<off_t>( static_cast<streamoff>(position) );
+        size_t nread(0);
+        while ( nread < size ) {
+            auto count = ::pread(m_fd, buffer + nread, size - nread, offset + nread);
+            if ( count < 0 && errno == EINTR ) {
+                continue;
+            } else if ( count <= 0 ) {
+                stringstream estream;
+                estream << "FATAL ERROR: positional read failed on " << m_path << endl;
+                estream << "\trequested : [" << offset << ", " << offset + size << ")" << endl;
+                estream << "\t" << ( count < 0 ? strerror(errno) : "unexpected end of file" ) << endl;
+                throw runtime_error(estream.str());
+            }
+            nread += count;
+        }
+    }
+    
+    const char * PositionalBackend::data(const boost::filesystem::fstream::pos_type, const size_t) const {
+        return nullptr;
+    }
+    
+    void PositionalBackend::update() {
+        // Positional reads always see the current content of the file
+    }
+    
+    PositionalBackend::~PositionalBackend() {
+        close();
+    }
+    
+    void PositionalBackend::close() {
+        if ( m_fd >= 0 ) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+    
+    bool PositionalBackend::m_is_registered(
+    PositionalBackend::factory_type::getFactory()->registerType("Positional",make_shared<PositionalBackend>())
+    );
+}
@@ -0,0 +1,202 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/ComputedIndexer.h>
+
+#include<SegyFile.h>
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/rev0/SegyFile-BinaryFileHeader-Rev0.h>
+#include<impl/rev1/SegyFile-Fields-Rev1.h>
+
+#include<algorithm>
+#include<limits>
+#include<sstream>
+#include<stdexcept>
+
+using namespace std;
+
+namespace seismic {
+    
+    ComputedIndexer::ComputedIndexer() : m_segy_file(nullptr), m_nsamples(0), m_trace_size(0), m_size(0) {
+    }
+    
+    void ComputedIndexer::reset_segy_file(SegyFile& segyFile) {
+        m_segy_file = &segyFile;
+        clear_index();
+    }
+    
+    void ComputedIndexer::create_index() {
+        computeIndex(nprobes);
+    }
+    
+    void ComputedIndexer::clear_index() {
+        m_full_scan.reset();
+        m_nsamples = 0;
+        m_trace_size = 0;
+        m_size = 0;
+    }
+    
+    boost::filesystem::fstream::pos_type ComputedIndexer::position(const size_t n) const {
+        if (m_full_scan) {
+            return m_full_scan->position(n);
+        }
+        if (n >= m_size) {
+            stringstream estream;
+            estream << "Trying to access trace " << n << " of an index with " << m_size << " traces" << endl;
+            throw out_of_range(estream.str());
+        }
+        return boost::filesystem::fstream::pos_type(3600 + static_cast<streamoff>(n * m_trace_size));
+    }
+    
+    size_t ComputedIndexer::size() const {
+        return m_full_scan ? m_full_scan->size() : m_size;
+    }
+    
+    size_t ComputedIndexer::nsamples(const size_t n) const {
+        if (m_full_scan) {
+            return m_full_scan->nsamples(n);
+        }
+        if (n >= m_size) {
+            stringstream estream;
+            estream << "Trying to access trace " << n << " of an index with " << m_size << " traces" << endl;
+            throw out_of_range(estream.str());
+        }
+        return m_nsamples;
+    }
+    
+    void ComputedIndexer::update_index() {
+        if (m_full_scan) {
+            m_full_scan->update_index();
+            return;
+        }
+        // Traces appended since the last update must all be checked, as 
+        // they may have been written with a different number of samples
+        if (m_size == 0) {
+            computeIndex(std::numeric_limits<size_t>::max());
+            return;
+        }
+        auto segyFileSize = fileSize();
+        auto ntraces = (segyFileSize - 3600) / m_trace_size;
+        if ( (segyFileSize - 3600) % m_trace_size != 0 || !checkFixedLength(m_size, ntraces, ntraces - m_size) ) {
+            fallBackToFullScan();
+            return;
+        }
+        m_size = ntraces;
+    }
+    
+    void ComputedIndexer::append_entries(const std::vector<IndexItem>& entries) {
+        if (m_full_scan) {
+            m_full_scan->append_entries(entries);
+            return;
+        }
+        if (m_size == 0) {
+            update_index();
+            return;
+        }
+        // Appended traces must still have the computed length and position
+        auto ntraces = m_size + entries.size();
+        bool fixedLength = (fileSize() - 3600) == ntraces * m_trace_size;
+        for (size_t ii = 0; fixedLength && ii < entries.size(); ++ii) {
+            fixedLength = entries[ii].nsamples() == m_nsamples && 
+                    entries[ii].position() == boost::filesystem::fstream::pos_type(3600 + static_cast<streamoff>((m_size + ii) * m_trace_size));
+        }
+        if (!fixedLength) {
+            fallBackToFullScan();
+            return;
+        }
+        m_size = ntraces;
+    }
+    
+    bool ComputedIndexer::computed() const {
+        return !m_full_scan;
+    }
+    
+    void ComputedIndexer::computeIndex(const size_t maxChecks) {
+        m_size = 0;
+        auto segyFileSize = fileSize();
+        if (segyFileSize == 3600) {
+            // No traces yet: the trace length is determined on update
+            return;
+        }
+        const auto& bfh = m_segy_file->getBinaryFileHeader();
+        m_nsamples = static_cast<uint16_t>( bfh[rev0::bfh::nsamplesDataTrace] );
+        if ( segyFileSize < 3600 || m_nsamples == 0 ) {
+            fallBackToFullScan();
+            return;
+        }
+        m_trace_size = TraceHeader::buffer_size + m_nsamples * constants::sizeOfDataSample(bfh[rev0::bfh::formatCode]);
+        if ( (segyFileSize - 3600) % m_trace_size != 0 ) {
+            fallBackToFullScan();
+            return;
+        }
+        auto ntraces = (segyFileSize - 3600) / m_trace_size;
+        // The flag is a guarantee: don't look at trace headers
+        bool fixedLength = m_segy_file->tag() == "Rev1" && bfh[rev1::bfh::fixedLengthTraceFlag] == 1;
+        if ( !fixedLength && !checkFixedLength(0, ntraces, maxChecks) ) {
+            fallBackToFullScan();
+            return;
+        }
+        m_size = ntraces;
+    }
+    
+    size_t ComputedIndexer::nsamplesAt(const boost::filesystem::fstream::pos_type position) const {
+        char th[TraceHeader::buffer_size];
+        m_segy_file->fstream().seekg(position);
+        m_segy_file->fstream().read(th, TraceHeader::buffer_size);
+        return static_cast<uint16_t>( TraceHeaderView(th)[rev0::th::nsamplesTrace] );
+    }
+    
+    size_t ComputedIndexer::fileSize() const {
+        // Seeking through the stream flushes any pending write
+        m_segy_file->fstream().seekg(0, ios::end);
+        return static_cast<size_t>( static_cast<streamoff>(m_segy_file->fstream().tellg()) );
+    }
+    
+    bool ComputedIndexer::checkFixedLength(const size_t first, const size_t size, const size_t maxChecks) const {
+        if (size <= first) {
+            return true;
+        }
+        // Sample the first and the last trace, plus a few in between
+        auto count = size - first;
+        auto nchecks = std::min(count, std::max<size_t>(maxChecks, 1));
+        for (size_t ii = 0; ii < nchecks; ++ii) {
+            auto n = first + ( nchecks == 1 ? 0 : ii * (count - 1) / (nchecks - 1) );
+            auto position = boost::filesystem::fstream::pos_type(3600 + static_cast<streamoff>(n * m_trace_size));
+            if ( nsamplesAt(position) != m_nsamples ) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void ComputedIndexer::fallBackToFullScan() {
+        m_full_scan = SegyFileIndexer::create("InMemory");
+        for (auto& x : header_indexes()) {
+            m_full_scan->attach_header_index(x);
+        }
+        m_full_scan->reset_segy_file(*m_segy_file);
+        m_full_scan->create_index();
+    }
+    
+    bool ComputedIndexer::m_is_registered(
+    ComputedIndexer::factory_type::getFactory()->registerType("Computed",make_shared<ComputedIndexer>())
+    );
+}
@@ -0,0 +1,58 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/HashHeaderIndex.h>
+
+using namespace std;
+
+namespace seismic {
+    
+    HashHeaderIndex::HashHeaderIndex(const HeaderKey& key) : HeaderIndex(key) {
+    }
+    
+    void HashHeaderIndex::clear_lookup() {
+        m_by_key.clear();
+        m_by_first.clear();
+    }
+    
+    void HashHeaderIndex::extend_lookup(const size_t first) {
+        for (size_t ii = first; ii < size(); ++ii) {
+            m_by_key[ recorded_key(ii) ].push_back(ii);
+            if ( key().size() == 2 ) {
+                m_by_first[ recorded_key(ii).first ].push_back(ii);
+            }
+        }
+    }
+    
+    HeaderIndex::result_type HashHeaderIndex::find_key(const key_type& key) const {
+        auto it = m_by_key.find(key);
+        return it == m_by_key.end() ? result_type() : it->second;
+    }
+    
+    HeaderIndex::result_type HashHeaderIndex::find_first(const int32_t value) const {
+        if ( key().size() == 1 ) {
+            return find_key( key_type(value, 0) );
+        }
+        auto it = m_by_first.find(value);
+        return it == m_by_first.end() ? result_type() : it->second;
+    }
+    
+}
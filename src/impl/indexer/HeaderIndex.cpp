@@ -0,0 +1,172 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/HeaderIndex.h>
+
+#include<impl/utilities-inl.h>
+
+#include<sstream>
+#include<stdexcept>
+
+using namespace std;
+
+namespace seismic {
+    
+    HeaderKey::value_type HeaderKey::operator()(const char * header) const {
+        return value_type(extract(header, m_first), extract(header, m_second));
+    }
+    
+    HeaderKey::value_type HeaderKey::operator()(const TraceHeader::smart_reference_type& header) const {
+        return value_type(extract(header, m_first), extract(header, m_second));
+    }
+    
+    int32_t HeaderKey::extract(const char * header, const Component& component) {
+        switch (component.size) {
+            case 4:
+                return readBigEndian<int32_t>(header + component.offset);
+            case 2:
+                return readBigEndian<int16_t>(header + component.offset);
+            default:
+                return 0;
+        }
+    }
+    
+    int32_t HeaderKey::extract(const TraceHeader::smart_reference_type& header, const Component& component) {
+        switch (component.size) {
+            case 4:
+                return header[Int32Field(component.offset)];
+            case 2:
+                return header[Int16Field(component.offset)];
+            default:
+                return 0;
+        }
+    }
+    
+    HeaderIndex::HeaderIndex(const HeaderKey& key, const bool retain_keys) : m_key(key), m_retain_keys(retain_keys), m_offset(0), m_nupdated(0), m_replaced(false) {
+    }
+    
+    const HeaderKey& HeaderIndex::key() const {
+        return m_key;
+    }
+    
+    size_t HeaderIndex::size() const {
+        return m_offset + m_keys.size();
+    }
+    
+    void HeaderIndex::insert(const size_t n, const char * header) {
+        record(n, m_key(header));
+    }
+    
+    void HeaderIndex::insert(const size_t n, const TraceHeader::smart_reference_type& header) {
+        record(n, m_key(header));
+    }
+    
+    void HeaderIndex::update() {
+        if (m_replaced) {
+            if (m_offset > 0) {
+                // Recover the keys that were dropped, to rebuild from scratch
+                vector<key_type> keys;
+                keys.reserve(size());
+                lookup_keys(keys);
+                for (const auto& x : m_replacements) {
+                    keys[x.first] = x.second;
+                }
+                keys.insert(keys.end(), m_keys.begin(), m_keys.end());
+                m_keys.swap(keys);
+                m_offset = 0;
+                m_replacements.clear();
+            }
+            clear_lookup();
+            m_nupdated = 0;
+            m_replaced = false;
+        }
+        if (m_nupdated < size()) {
+            extend_lookup(m_nupdated);
+            m_nupdated = size();
+        }
+        if (!m_retain_keys && !m_keys.empty()) {
+            // The lookup structures are now the only copy of the keys
+            vector<key_type>().swap(m_keys);
+            m_offset = m_nupdated;
+        }
+    }
+    
+    void HeaderIndex::clear() {
+        m_keys.clear();
+        m_offset = 0;
+        m_replacements.clear();
+        clear_lookup();
+        m_nupdated = 0;
+        m_replaced = false;
+    }
+    
+    HeaderIndex::result_type HeaderIndex::find(const key_type& key) const {
+        return find_key(key);
+    }
+    
+    HeaderIndex::result_type HeaderIndex::findFirst(const int32_t value) const {
+        return find_first(value);
+    }
+    
+    HeaderIndex::~HeaderIndex() {
+    }
+    
+    const HeaderIndex::key_type& HeaderIndex::recorded_key(const size_t n) const {
+        return m_keys[n - m_offset];
+    }
+    
+    HeaderIndex::key_type HeaderIndex::lookup_key(const size_t n) const {
+        stringstream estream;
+        estream << "FATAL ERROR: the key of trace " << n << " is neither retained nor recoverable" << endl;
+        throw logic_error(estream.str());
+    }
+    
+    void HeaderIndex::lookup_keys(std::vector<key_type>& /* keys */) const {
+        stringstream estream;
+        estream << "FATAL ERROR: the keys of " << m_offset << " traces are neither retained nor recoverable" << endl;
+        throw logic_error(estream.str());
+    }
+    
+    void HeaderIndex::record(const size_t n, const key_type& key) {
+        if (n == size()) {
+            m_keys.push_back(key);
+        } else if (n >= m_offset && n < size()) {
+            auto& recorded = m_keys[n - m_offset];
+            if (recorded != key) {
+                recorded = key;
+                m_replaced = m_replaced || n < m_nupdated;
+            }
+        } else if (n < m_offset) {
+            // The key was dropped: compare with the one in the lookup structures
+            auto x = m_replacements.find(n);
+            if ((x != m_replacements.end() ? x->second : lookup_key(n)) != key) {
+                m_replacements[n] = key;
+                m_replaced = true;
+            }
+        } else {
+            stringstream estream;
+            estream << "FATAL ERROR: trying to record the key of trace " << n;
+            estream << " in a header index that holds " << size() << " keys" << endl;
+            throw runtime_error(estream.str());
+        }
+    }
+    
+}
@@ -0,0 +1,166 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/ParallelHeaderScanner.h>
+
+#include<impl/SegyFile-TraceHeader.h>
+#include<impl/SegyFile-TraceView.h>
+#include<impl/rev0/SegyFile-Fields-Rev0.h>
+
+#include<algorithm>
+#include<thread>
+#include<utility>
+#include<vector>
+
+using namespace std;
+
+namespace seismic {
+    
+    namespace {
+        
+        /// Maximum number of traces walked by a thread in a single round
+        const size_t max_traces_per_chunk = 1 << 20;
+        
+        /// Size of the window through which headers are read
+        const size_t window_size = 1 << 20;
+        
+        /**
+         * @brief Reads trace headers through a window, so that headers of 
+         * short traces are fetched with a few large reads
+         */
+        class HeaderReader {
+        public:
+            HeaderReader(const boost::filesystem::path& path, const uint64_t fileSize, const uint64_t traceSize) 
+            : m_stream(path, ios::binary | ios::in), m_file_size(fileSize), m_begin(0), m_end(0) {
+                // Read whole windows only if they contain several headers
+                m_read_size = traceSize * 16 <= window_size ? window_size : TraceHeader::buffer_size;
+            }
+            
+            /// Returns the number of samples of the trace at position, or false if it can't be read
+            bool nsamples(const uint64_t position, size_t& nsamples) {
+                if ( position + TraceHeader::buffer_size > m_file_size ) {
+                    return false;
+                }
+                if ( position < m_begin || position + TraceHeader::buffer_size > m_end ) {
+                    auto size = std::min<uint64_t>(m_read_size, m_file_size - position);
+                    m_window.resize(size);
+                    m_stream.clear();
+                    m_stream.seekg(static_cast<streamoff>(position));
+                    if ( !m_stream.read(m_window.data(), size) ) {
+                        return false;
+                    }
+                    m_begin = position;
+                    m_end = position + size;
+                }
+                TraceHeaderView header(m_window.data() + (position - m_begin));
+                nsamples = static_cast<uint16_t>( header[rev0::th::nsamplesTrace] );
+                return true;
+            }
+            
+        private:
+            boost::filesystem::ifstream m_stream;
+            uint64_t m_file_size;
+            uint64_t m_read_size;
+            uint64_t m_begin;
+            uint64_t m_end;
+            vector<char> m_window;
+        };
+        
+        /// Traces found by walking a chunk
+        struct Walk {
+            vector< pair<uint64_t, size_t> > traces;
+            uint64_t end{0};
+            bool failed{false};
+        };
+        
+        void walk(const boost::filesystem::path& path, const uint64_t fileSize, const size_t sizeOfDataSample,
+                const uint64_t traceSize, const uint64_t begin, const uint64_t stop, Walk& result) {
+            HeaderReader reader(path, fileSize, traceSize);
+            // A walk that starts inside trace data may decode zeros as empty 
+            // traces, and step through the chunk 240 bytes at a time: it stops 
+            // once it finds far more traces than predicted. If it did start on 
+            // a trace, the traces found so far are still stitched, and the 
+            // next round starts where it stopped
+            const uint64_t max_traces = 2 * ( (stop - begin) / traceSize ) + 1;
+            auto position = begin;
+            while ( position < stop && result.traces.size() < max_traces ) {
+                size_t nsamples(0);
+                if ( !reader.nsamples(position, nsamples) ) {
+                    result.failed = true;
+                    break;
+                }
+                result.traces.emplace_back(position, nsamples);
+                position += TraceHeader::buffer_size + nsamples * sizeOfDataSample;
+            }
+            result.end = position;
+            result.failed = result.failed || position > fileSize;
+        }
+    }
+    
+    ParallelHeaderScanner::ParallelHeaderScanner(const boost::filesystem::path& path, const size_t sizeOfDataSample, const size_t nthreads, const size_t minTracesPerChunk)
+    : m_path(path), m_size_of_data_sample(sizeOfDataSample), m_nthreads(nthreads), m_min_traces_per_chunk(std::max<size_t>(minTracesPerChunk, 1)) {
+    }
+    
+    ParallelHeaderScanner::position_type ParallelHeaderScanner::scan(const position_type begin, const sink_type& sink) const {
+        const uint64_t fileSize = file_size(m_path);
+        uint64_t position = static_cast<uint64_t>( static_cast<streamoff>(begin) );
+        HeaderReader reader(m_path, fileSize, window_size);
+        while ( position < fileSize ) {
+            // Predict trace boundaries from the length of the current trace
+            size_t nsamples(0);
+            if ( !reader.nsamples(position, nsamples) ) {
+                break;
+            }
+            uint64_t traceSize = TraceHeader::buffer_size + nsamples * m_size_of_data_sample;
+            uint64_t ntraces = (fileSize - position) / traceSize;
+            size_t nchunks = static_cast<size_t>( std::min<uint64_t>(m_nthreads, ntraces / m_min_traces_per_chunk) );
+            if ( nchunks < 2 ) {
+                break;
+            }
+            ntraces = std::min<uint64_t>(ntraces, nchunks * max_traces_per_chunk);
+            vector<uint64_t> starts(nchunks + 1);
+            for (size_t ii = 0; ii <= nchunks; ++ii) {
+                starts[ii] = position + (ii * ntraces / nchunks) * traceSize;
+            }
+            // Walk each chunk speculatively
+            vector<Walk> walks(nchunks);
+            vector<thread> threads;
+            for (size_t ii = 0; ii < nchunks; ++ii) {
+                threads.emplace_back(walk, std::cref(m_path), fileSize, m_size_of_data_sample, traceSize, starts[ii], starts[ii + 1], std::ref(walks[ii]));
+            }
+            for (auto& x : threads) {
+                x.join();
+            }
+            // Stitch the walks that start where the previous one ended
+            for (size_t ii = 0; ii < nchunks && starts[ii] == position; ++ii) {
+                if ( walks[ii].failed ) {
+                    return position_type( static_cast<streamoff>(position) );
+                }
+                for (auto& x : walks[ii].traces) {
+                    sink(position_type( static_cast<streamoff>(x.first) ), x.second);
+                }
+                position = walks[ii].end;
+            }
+        }
+        return position_type( static_cast<streamoff>(position) );
+    }
+    
+}
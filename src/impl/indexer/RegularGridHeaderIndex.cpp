@@ -0,0 +1,309 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/RegularGridHeaderIndex.h>
+
+#include<algorithm>
+#include<cstdlib>
+
+using namespace std;
+
+namespace seismic {
+    
+    namespace {
+        int32_t gcd(int32_t a, int32_t b) {
+            while (b != 0) {
+                auto t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+    }
+    
+    void RegularGridHeaderIndex::AxisBuilder::add(const int32_t value) {
+        if (empty) {
+            axis.min = axis.max = origin = value;
+            empty = false;
+            return;
+        }
+        axis.min = std::min(axis.min, value);
+        axis.max = std::max(axis.max, value);
+        axis.stride = gcd(axis.stride, static_cast<int32_t>( std::abs(static_cast<int64_t>(value) - origin) ));
+    }
+    
+    RegularGridHeaderIndex::RegularGridHeaderIndex(const HeaderKey& key) : HeaderIndex(key, false) {
+    }
+    
+    bool RegularGridHeaderIndex::firstMajor() const {
+        return m_first_major;
+    }
+    
+    const RegularGridHeaderIndex::Axis& RegularGridHeaderIndex::first() const {
+        return m_first.axis;
+    }
+    
+    const RegularGridHeaderIndex::Axis& RegularGridHeaderIndex::second() const {
+        return m_second.axis;
+    }
+    
+    bool RegularGridHeaderIndex::regular() const {
+        return m_duplicates == 0;
+    }
+    
+    size_t RegularGridHeaderIndex::nruns() const {
+        return m_runs.size();
+    }
+    
+    bool RegularGridHeaderIndex::locate(const key_type& key, size_t& n) const {
+        auto slow = m_first_major ? key.first : key.second;
+        auto fast = m_first_major ? key.second : key.first;
+        auto line = m_lines.find(slow);
+        if (line == m_lines.end()) {
+            return false;
+        }
+        size_t k;
+        for (auto ii : line->second) {
+            if ( offset(m_runs[ii], fast, k) ) {
+                n = m_runs[ii].trace + k;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    HeaderIndex::result_type RegularGridHeaderIndex::findSecond(const int32_t value) const {
+        return m_first_major ? findFast(value) : findSlow(value);
+    }
+    
+    vector<RegularGridHeaderIndex::Segment> RegularGridHeaderIndex::segmentsFirst(const int32_t value) const {
+        return m_first_major ? segmentsSlow(value) : segmentsFast(value);
+    }
+    
+    vector<RegularGridHeaderIndex::Segment> RegularGridHeaderIndex::segmentsSecond(const int32_t value) const {
+        return m_first_major ? segmentsFast(value) : segmentsSlow(value);
+    }
+    
+    vector<RegularGridHeaderIndex::Segment> RegularGridHeaderIndex::segments() const {
+        auto nsecond = second().size();
+        vector<Segment> result;
+        result.reserve(m_runs.size());
+        for (const auto& x : m_runs) {
+            auto i = cell(slow(), x.slow);
+            auto j = cell(fast(), x.fast);
+            if (m_first_major) {
+                result.push_back(Segment{x.trace, x.count, i * nsecond + j, step(x)});
+            } else {
+                result.push_back(Segment{x.trace, x.count, j * nsecond + i, step(x) * static_cast<ptrdiff_t>(nsecond)});
+            }
+        }
+        return result;
+    }
+    
+    void RegularGridHeaderIndex::clear_lookup() {
+        m_runs.clear();
+        m_lines.clear();
+        m_oriented = false;
+        m_first_major = true;
+        m_first = AxisBuilder();
+        m_second = AxisBuilder();
+        m_duplicates = 0;
+    }
+    
+    void RegularGridHeaderIndex::extend_lookup(const size_t first) {
+        // The sort order is detected on the first pair of consecutive traces
+        // on the same line: a line with a single trace, or a hole, says nothing
+        vector<key_type> previousKeys;
+        for (size_t ii = std::max<size_t>(first, 1); !m_oriented && ii < size(); ++ii) {
+            auto previous = ii - 1 < first ? lookup_key(ii - 1) : recorded_key(ii - 1);
+            const auto& current = recorded_key(ii);
+            if ( (previous.first == current.first) == (previous.second == current.second) ) {
+                continue;
+            }
+            // Until now traces have been taken as sorted by the first field
+            if ( previous.second == current.second && first > 0 ) {
+                lookup_keys(previousKeys);
+                clear_lookup();
+            }
+            m_first_major = previous.first == current.first;
+            m_oriented = true;
+        }
+        for (size_t ii = 0; ii < previousKeys.size(); ++ii) {
+            add(ii, previousKeys[ii]);
+        }
+        for (size_t ii = first; ii < size(); ++ii) {
+            add(ii, recorded_key(ii));
+        }
+    }
+    
+    void RegularGridHeaderIndex::add(const size_t n, const key_type& key) {
+        size_t previous;
+        if ( locate(key, previous) ) {
+            ++m_duplicates;
+        }
+        m_first.add(key.first);
+        m_second.add(key.second);
+        auto slow = m_first_major ? key.first : key.second;
+        auto fast = m_first_major ? key.second : key.first;
+        // Extend the last run, if possible
+        if ( !m_runs.empty() ) {
+            auto& last = m_runs.back();
+            if ( last.slow == slow && last.trace + last.count == n ) {
+                // The second trace of a run sets its stride, in either direction
+                auto distance = static_cast<int64_t>(fast) - last.fast;
+                if ( last.count == 1 && distance != 0 && distance == static_cast<int32_t>(distance) ) {
+                    last.stride = static_cast<int32_t>(distance);
+                    ++last.count;
+                    return;
+                }
+                if ( last.stride != 0 && static_cast<int64_t>(fast) == last.fast + static_cast<int64_t>(last.count) * last.stride ) {
+                    ++last.count;
+                    return;
+                }
+            }
+        }
+        m_lines[slow].push_back(m_runs.size());
+        m_runs.push_back(Run{slow, fast, 1, n, 0});
+    }
+    
+    HeaderIndex::key_type RegularGridHeaderIndex::lookup_key(const size_t n) const {
+        // Runs are stored in trace order
+        auto run = upper_bound(m_runs.begin(), m_runs.end(), n, [](const size_t trace, const Run& x) {
+            return trace < x.trace;
+        });
+        return runKey(*(run - 1), n - (run - 1)->trace);
+    }
+    
+    void RegularGridHeaderIndex::lookup_keys(vector<key_type>& keys) const {
+        for (const auto& x : m_runs) {
+            for (size_t k = 0; k < x.count; ++k) {
+                keys.push_back(runKey(x, k));
+            }
+        }
+    }
+    
+    HeaderIndex::key_type RegularGridHeaderIndex::runKey(const Run& run, const size_t k) const {
+        auto fast = static_cast<int32_t>( run.fast + static_cast<int64_t>(k) * run.stride );
+        return m_first_major ? key_type(run.slow, fast) : key_type(fast, run.slow);
+    }
+    
+    HeaderIndex::result_type RegularGridHeaderIndex::find_key(const key_type& key) const {
+        auto slow = m_first_major ? key.first : key.second;
+        auto fast = m_first_major ? key.second : key.first;
+        result_type result;
+        auto line = m_lines.find(slow);
+        if (line != m_lines.end()) {
+            for (auto ii : line->second) {
+                match(m_runs[ii], fast, result);
+            }
+        }
+        return result;
+    }
+    
+    HeaderIndex::result_type RegularGridHeaderIndex::find_first(const int32_t value) const {
+        return m_first_major ? findSlow(value) : findFast(value);
+    }
+    
+    bool RegularGridHeaderIndex::offset(const Run& run, const int32_t value, size_t& k) const {
+        auto distance = static_cast<int64_t>(value) - run.fast;
+        if ( distance == 0 ) {
+            k = 0;
+            return true;
+        }
+        if ( run.stride != 0 && distance % run.stride == 0 ) {
+            auto steps = distance / run.stride;
+            if ( steps > 0 && steps < static_cast<int64_t>(run.count) ) {
+                k = static_cast<size_t>(steps);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void RegularGridHeaderIndex::match(const Run& run, const int32_t value, result_type& result) const {
+        size_t k;
+        if ( offset(run, value, k) ) {
+            result.push_back(run.trace + k);
+        }
+    }
+    
+    HeaderIndex::result_type RegularGridHeaderIndex::findSlow(const int32_t value) const {
+        result_type result;
+        auto line = m_lines.find(value);
+        if (line != m_lines.end()) {
+            for (auto ii : line->second) {
+                for (size_t jj = 0; jj < m_runs[ii].count; ++jj) {
+                    result.push_back(m_runs[ii].trace + jj);
+                }
+            }
+        }
+        return result;
+    }
+    
+    HeaderIndex::result_type RegularGridHeaderIndex::findFast(const int32_t value) const {
+        result_type result;
+        for (const auto& x : m_runs) {
+            match(x, value, result);
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+    
+    vector<RegularGridHeaderIndex::Segment> RegularGridHeaderIndex::segmentsSlow(const int32_t value) const {
+        vector<Segment> result;
+        auto line = m_lines.find(value);
+        if (line != m_lines.end()) {
+            for (auto ii : line->second) {
+                const auto& x = m_runs[ii];
+                result.push_back(Segment{x.trace, x.count, cell(fast(), x.fast), step(x)});
+            }
+        }
+        return result;
+    }
+    
+    vector<RegularGridHeaderIndex::Segment> RegularGridHeaderIndex::segmentsFast(const int32_t value) const {
+        vector<Segment> result;
+        size_t k;
+        for (const auto& x : m_runs) {
+            if ( offset(x, value, k) ) {
+                result.push_back(Segment{x.trace + k, 1, cell(slow(), x.slow), 0});
+            }
+        }
+        return result;
+    }
+    
+    size_t RegularGridHeaderIndex::cell(const Axis& axis, const int32_t value) {
+        return axis.stride == 0 ? 0 : static_cast<size_t>( (static_cast<int64_t>(value) - axis.min) / axis.stride );
+    }
+    
+    const RegularGridHeaderIndex::Axis& RegularGridHeaderIndex::slow() const {
+        return m_first_major ? first() : second();
+    }
+    
+    const RegularGridHeaderIndex::Axis& RegularGridHeaderIndex::fast() const {
+        return m_first_major ? second() : first();
+    }
+    
+    ptrdiff_t RegularGridHeaderIndex::step(const Run& run) const {
+        return fast().stride == 0 ? 0 : run.stride / fast().stride;
+    }
+    
+}
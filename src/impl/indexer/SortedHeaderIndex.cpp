@@ -0,0 +1,77 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/indexer/SortedHeaderIndex.h>
+
+#include<algorithm>
+
+using namespace std;
+
+namespace seismic {
+    
+    SortedHeaderIndex::SortedHeaderIndex(const HeaderKey& key) : HeaderIndex(key) {
+    }
+    
+    void SortedHeaderIndex::clear_lookup() {
+        m_sorted.clear();
+    }
+    
+    void SortedHeaderIndex::extend_lookup(const size_t first) {
+        auto middle = m_sorted.size();
+        for (size_t ii = first; ii < size(); ++ii) {
+            m_sorted.emplace_back(recorded_key(ii), ii);
+        }
+        // Ties are broken by trace id, so that results come out in order
+        sort(m_sorted.begin() + middle, m_sorted.end());
+        inplace_merge(m_sorted.begin(), m_sorted.begin() + middle, m_sorted.end());
+    }
+    
+    HeaderIndex::result_type SortedHeaderIndex::find_key(const key_type& key) const {
+        auto lower = lower_bound(m_sorted.begin(), m_sorted.end(), key, 
+                [](const pair<key_type, size_t>& a, const key_type& b) { return a.first < b; }
+        );
+        auto upper = upper_bound(lower, m_sorted.end(), key, 
+                [](const key_type& a, const pair<key_type, size_t>& b) { return a < b.first; }
+        );
+        result_type result;
+        for (auto it = lower; it != upper; ++it) {
+            result.push_back(it->second);
+        }
+        return result;
+    }
+    
+    HeaderIndex::result_type SortedHeaderIndex::find_first(const int32_t value) const {
+        auto lower = lower_bound(m_sorted.begin(), m_sorted.end(), value, 
+                [](const pair<key_type, size_t>& a, int32_t b) { return a.first.first < b; }
+        );
+        auto upper = upper_bound(lower, m_sorted.end(), value, 
+                [](int32_t a, const pair<key_type, size_t>& b) { return a < b.first.first; }
+        );
+        result_type result;
+        for (auto it = lower; it != upper; ++it) {
+            result.push_back(it->second);
+        }
+        // Matching traces are sorted by the second field first
+        sort(result.begin(), result.end());
+        return result;
+    }
+    
+}
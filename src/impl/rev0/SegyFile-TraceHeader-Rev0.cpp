@@ -213,22 +213,18 @@ namespace seismic {
     }
     
     void ConcreteTraceHeader<Rev0>::invertByteOrder() {
-        // Invert int32_t fields
-        std::for_each(
-                ConcreteTraceHeader<Rev0>::Int32List().begin(),
-                ConcreteTraceHeader<Rev0>::Int32List().end(),
-                [this](const Int32Field & idx) {
-                    seismic::invertByteOrder((*this)[idx]);
-                }
-        );
-        // Invert int16_t fields
-        std::for_each(
-                ConcreteTraceHeader<Rev0>::Int16List().begin(),
-                ConcreteTraceHeader<Rev0>::Int16List().end(),
-                [this](const Int16Field & idx) {
-                    seismic::invertByteOrder((*this)[idx]);
-                }
-        );
+        ConcreteTraceHeader<Rev0>::permutation().apply(get());
+    }
+    
+    const ByteOrderPermutation<TraceHeader::buffer_size> * ConcreteTraceHeader<Rev0>::byteOrderPermutation() {
+        return &ConcreteTraceHeader<Rev0>::permutation();
+    }
+    
+    const ByteOrderPermutation<TraceHeader::buffer_size>& ConcreteTraceHeader<Rev0>::permutation() {
+        static const ByteOrderPermutation<buffer_size> permutation( 
+                ByteOrderPermutation<buffer_size>().add( ConcreteTraceHeader<Rev0>::Int32List() ).add( ConcreteTraceHeader<Rev0>::Int16List() ) 
+                );
+        return permutation;
     }
     
     void ConcreteTraceHeader<Rev0>::checkConsistencyOrThrow() const {
@@ -105,20 +105,19 @@ namespace seismic {
     
     
     void ConcreteTraceHeader<Rev1>::invertByteOrder() {
-        ConcreteTraceHeader<Rev0>::invertByteOrder();
-        std::for_each(
-                ConcreteTraceHeader<Rev1>::Int32List().begin(),
-                ConcreteTraceHeader<Rev1>::Int32List().end(),
-                [this](const Int32Field & idx) {
-                    seismic::invertByteOrder((*this)[idx]);
-                }
-        );
-        std::for_each(
-                ConcreteTraceHeader<Rev1>::Int16List().begin(),
-                ConcreteTraceHeader<Rev1>::Int16List().end(),
-                [this](const Int16Field & idx) {
-                    seismic::invertByteOrder((*this)[idx]);
-                });
+        ConcreteTraceHeader<Rev1>::permutation().apply(get());
+    }
+    
+    const ByteOrderPermutation<TraceHeader::buffer_size> * ConcreteTraceHeader<Rev1>::byteOrderPermutation() {
+        return &ConcreteTraceHeader<Rev1>::permutation();
+    }
+    
+    const ByteOrderPermutation<TraceHeader::buffer_size>& ConcreteTraceHeader<Rev1>::permutation() {
+        // Fields of Rev0, plus fields that are specific to Rev1
+        static const ByteOrderPermutation<buffer_size> permutation( 
+                ByteOrderPermutation<buffer_size>( ConcreteTraceHeader<Rev0>::permutation() ).add( ConcreteTraceHeader<Rev1>::Int32List() ).add( ConcreteTraceHeader<Rev1>::Int16List() ) 
+                );
+        return permutation;
     }
     
     void ConcreteTraceHeader<Rev1>::checkConsistencyOrThrow() const {
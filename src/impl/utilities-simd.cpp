@@ -0,0 +1,581 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include<impl/utilities-inl.h>
+
+#include<cstring>
+#include<stdexcept>
+#include<type_traits>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define SEISMIC_X86_KERNELS
+#include<immintrin.h>
+#endif
+
+namespace seismic {
+
+    namespace {
+        
+        ////////////////////
+        // Every kernel converts nelements elements from source to destination. 
+        // Source and destination are either equal or non-overlapping, and 
+        // have no alignment requirement.
+        ////////////////////
+        
+        using kernel_type = void (*)(const char *, char *, size_t);
+        
+        /// Shuffles nblocks blocks of 16 bytes, with one permutation per block
+        using permute_kernel_type = void (*)(const char *, char *, const uint8_t *, size_t);
+        
+        ////////////////////
+        //// Scalar kernels
+        ////////////////////
+        
+        template< class T >
+        inline T bswap(T value);
+        
+#if defined(__GNUC__)
+        template<>
+        inline uint16_t bswap(uint16_t value) {
+            return __builtin_bswap16(value);
+        }
+        
+        template<>
+        inline uint32_t bswap(uint32_t value) {
+            return __builtin_bswap32(value);
+        }
+        
+        template<>
+        inline uint64_t bswap(uint64_t value) {
+            return __builtin_bswap64(value);
+        }
+#else
+        template< class T >
+        inline T bswap(T value) {
+            invertByteOrder(value);
+            return value;
+        }
+#endif
+        
+        template< class T >
+        void swapScalar(const char * source, char * destination, size_t nelements) {
+            for (size_t ii = 0; ii < nelements; ++ii) {
+                T value;
+                std::memcpy(&value, source + ii * sizeof(T), sizeof(T));
+                value = bswap(value);
+                std::memcpy(destination + ii * sizeof(T), &value, sizeof(T));
+            }
+        }
+        
+        inline uint32_t ibm2ieeeBits(const uint32_t value) {
+#if defined(__GNUC__)
+            // Same algorithm as ibm2ieee(int32_t&), with the normalization
+            // loop replaced by a count of the leading zeros of the mantissa
+            const uint32_t sign = value & 0x80000000u;
+            const uint32_t fmant = value & 0x00ffffffu;
+            const int32_t lz = __builtin_clz(fmant | 1u) - 8;
+            const int32_t t = static_cast<int32_t>( (value & 0x7f000000u) >> 22 ) - 130 - lz;
+            const uint32_t normal = sign | ( static_cast<uint32_t>(t) << 23 ) | ( (fmant << lz) & 0x007fffffu );
+            const uint32_t overflow = sign | 0x7f7fffffu;
+            return ( fmant == 0 || t <= 0 ) ? 0 : ( t > 254 ? overflow : normal );
+#else
+            int32_t converted = static_cast<int32_t>(value);
+            ibm2ieee(converted);
+            return static_cast<uint32_t>(converted);
+#endif
+        }
+        
+        inline uint32_t ieee2ibmBits(const uint32_t value) {
+            // Same algorithm as ieee2ibm(int32_t&), with the loop that aligns
+            // the exponent to a power of 16 replaced by a single shift
+            uint32_t fmant = (value & 0x007fffffu) | 0x00800000u;
+            int32_t t = static_cast<int32_t>( (value & 0x7f800000u) >> 23 ) - 126;
+            const int32_t shift = (-t) & 0x3;
+            t += shift;
+            fmant >>= shift;
+            const uint32_t converted = (value & 0x80000000u) | ( static_cast<uint32_t>( (t >> 2) + 64 ) << 24 ) | fmant;
+            return value == 0 ? 0 : converted;
+        }
+        
+        template< bool Swap >
+        void ibm2ieeeScalar(const char * source, char * destination, size_t nvalues) {
+            for (size_t ii = 0; ii < nvalues; ++ii) {
+                uint32_t value;
+                std::memcpy(&value, source + ii * sizeof(value), sizeof(value));
+                if (Swap) {
+                    value = bswap(value);
+                }
+                value = ibm2ieeeBits(value);
+                std::memcpy(destination + ii * sizeof(value), &value, sizeof(value));
+            }
+        }
+        
+        template< bool Swap >
+        void ieee2ibmScalar(const char * source, char * destination, size_t nvalues) {
+            for (size_t ii = 0; ii < nvalues; ++ii) {
+                uint32_t value;
+                std::memcpy(&value, source + ii * sizeof(value), sizeof(value));
+                value = ieee2ibmBits(value);
+                if (Swap) {
+                    value = bswap(value);
+                }
+                std::memcpy(destination + ii * sizeof(value), &value, sizeof(value));
+            }
+        }
+        
+        void permuteScalar(const char * source, char * destination, const uint8_t * permutation, size_t nblocks) {
+            for (size_t ii = 0; ii < nblocks; ++ii) {
+                char block[16];
+                std::memcpy(block, source + 16 * ii, 16);
+                for (size_t jj = 0; jj < 16; ++jj) {
+                    destination[16 * ii + jj] = block[ permutation[16 * ii + jj] ];
+                }
+            }
+        }
+        
+#ifdef SEISMIC_X86_KERNELS
+        ////////////////////
+        //// SSE2 kernels
+        ////////////////////
+        
+        __attribute__((target("sse2")))
+        inline __m128i swapBytesInWords(__m128i v) {
+            return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        }
+        
+        __attribute__((target("sse2")))
+        inline __m128i swapSSE2(__m128i v, std::integral_constant<size_t, 2>) {
+            return swapBytesInWords(v);
+        }
+
+        __attribute__((target("sse2")))
+        inline __m128i swapSSE2(__m128i v, std::integral_constant<size_t, 4>) {
+            // Swap the 16-bit words within each 32-bit element, then the bytes within each word
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            return swapBytesInWords(v);
+        }
+
+        __attribute__((target("sse2")))
+        inline __m128i swapSSE2(__m128i v, std::integral_constant<size_t, 8>) {
+            // Reverse the 16-bit words within each 64-bit element, then the bytes within each word
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+            return swapBytesInWords(v);
+        }
+        
+        template< class T >
+        __attribute__((target("sse2")))
+        void swapSSE2(const char * source, char * destination, size_t nelements) {
+            const size_t nbytes = nelements * sizeof(T);
+            size_t ii = 0;
+            for (; ii + 16 <= nbytes; ii += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + ii));
+                v = swapSSE2(v, std::integral_constant<size_t, sizeof(T)>());
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + ii), v);
+            }
+            swapScalar<T>(source + ii, destination + ii, (nbytes - ii) / sizeof(T));
+        }
+        
+        __attribute__((target("sse2")))
+        inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+        
+        __attribute__((target("sse2")))
+        inline __m128i ibm2ieeeVector(__m128i v) {
+            const __m128i sign = _mm_and_si128(v, _mm_set1_epi32(0x80000000));
+            const __m128i fmant = _mm_and_si128(v, _mm_set1_epi32(0x00ffffff));
+            const __m128i e4 = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x7f000000)), 22);
+            // The mantissa fits 24 bits: its conversion to float is exact and 
+            // yields both the normalized mantissa and the normalization shift
+            const __m128i f = _mm_castps_si128(_mm_cvtepi32_ps(fmant));
+            const __m128i t = _mm_sub_epi32(_mm_add_epi32(e4, _mm_srli_epi32(f, 23)), _mm_set1_epi32(280));
+            __m128i result = _mm_or_si128(_mm_or_si128(sign, _mm_slli_epi32(t, 23)), _mm_and_si128(f, _mm_set1_epi32(0x007fffff)));
+            result = select(_mm_cmpgt_epi32(t, _mm_set1_epi32(254)), _mm_or_si128(sign, _mm_set1_epi32(0x7f7fffff)), result);
+            const __m128i zero = _mm_or_si128(_mm_cmplt_epi32(t, _mm_set1_epi32(1)), _mm_cmpeq_epi32(fmant, _mm_setzero_si128()));
+            return _mm_andnot_si128(zero, result);
+        }
+        
+        __attribute__((target("sse2")))
+        inline __m128i ieee2ibmVector(__m128i v) {
+            __m128i fmant = _mm_or_si128(_mm_and_si128(v, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x00800000));
+            __m128i t = _mm_sub_epi32(_mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0x7f800000)), 23), _mm_set1_epi32(126));
+            const __m128i shift = _mm_and_si128(_mm_sub_epi32(_mm_setzero_si128(), t), _mm_set1_epi32(3));
+            t = _mm_add_epi32(t, shift);
+            // No variable shift in SSE2: shift by one bit of the amount at a time
+            const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+            fmant = select(_mm_cmpeq_epi32(_mm_and_si128(shift, one), one), _mm_srli_epi32(fmant, 1), fmant);
+            fmant = select(_mm_cmpeq_epi32(_mm_and_si128(shift, two), two), _mm_srli_epi32(fmant, 2), fmant);
+            const __m128i exponent = _mm_slli_epi32(_mm_add_epi32(_mm_srai_epi32(t, 2), _mm_set1_epi32(64)), 24);
+            const __m128i result = _mm_or_si128(_mm_or_si128(_mm_and_si128(v, _mm_set1_epi32(0x80000000)), exponent), fmant);
+            return _mm_andnot_si128(_mm_cmpeq_epi32(v, _mm_setzero_si128()), result);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("sse2")))
+        void ibm2ieeeSSE2(const char * source, char * destination, size_t nvalues) {
+            size_t ii = 0;
+            for (; ii + 4 <= nvalues; ii += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 4 * ii));
+                if (Swap) {
+                    v = swapSSE2(v, std::integral_constant<size_t, 4>());
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 4 * ii), ibm2ieeeVector(v));
+            }
+            ibm2ieeeScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("sse2")))
+        void ieee2ibmSSE2(const char * source, char * destination, size_t nvalues) {
+            size_t ii = 0;
+            for (; ii + 4 <= nvalues; ii += 4) {
+                __m128i v = ieee2ibmVector(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 4 * ii)));
+                if (Swap) {
+                    v = swapSSE2(v, std::integral_constant<size_t, 4>());
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 4 * ii), v);
+            }
+            ieee2ibmScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+        
+        ////////////////////
+        //// SSSE3 kernels
+        ////////////////////
+        
+        __attribute__((target("ssse3")))
+        void permuteSSSE3(const char * source, char * destination, const uint8_t * permutation, size_t nblocks) {
+            for (size_t ii = 0; ii < nblocks; ++ii) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 16 * ii));
+                __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(permutation + 16 * ii));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 16 * ii), _mm_shuffle_epi8(v, mask));
+            }
+        }
+        
+        ////////////////////
+        //// AVX2 kernels
+        ////////////////////
+        
+        template< class T >
+        __attribute__((target("avx2")))
+        inline __m256i shuffleMask256() {
+            // Byte permutation that reverses each element of a 128-bit lane
+            char mask[32];
+            for (int ii = 0; ii < 32; ++ii) {
+                mask[ii] = static_cast<char>( (ii & 15) - (ii % sizeof(T)) + (sizeof(T) - 1 - ii % sizeof(T)) );
+            }
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask));
+        }
+        
+        template< class T >
+        __attribute__((target("avx2")))
+        void swapAVX2(const char * source, char * destination, size_t nelements) {
+            const size_t nbytes = nelements * sizeof(T);
+            const __m256i mask = shuffleMask256<T>();
+            size_t ii = 0;
+            for (; ii + 64 <= nbytes; ii += 64) {
+                __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + ii));
+                __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + ii + 32));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + ii), _mm256_shuffle_epi8(v0, mask));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + ii + 32), _mm256_shuffle_epi8(v1, mask));
+            }
+            for (; ii + 32 <= nbytes; ii += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + ii));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + ii), _mm256_shuffle_epi8(v, mask));
+            }
+            swapScalar<T>(source + ii, destination + ii, (nbytes - ii) / sizeof(T));
+        }
+        
+        __attribute__((target("avx2")))
+        inline __m256i ibm2ieeeVector(__m256i v) {
+            const __m256i sign = _mm256_and_si256(v, _mm256_set1_epi32(0x80000000));
+            const __m256i fmant = _mm256_and_si256(v, _mm256_set1_epi32(0x00ffffff));
+            const __m256i e4 = _mm256_srli_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0x7f000000)), 22);
+            const __m256i f = _mm256_castps_si256(_mm256_cvtepi32_ps(fmant));
+            const __m256i t = _mm256_sub_epi32(_mm256_add_epi32(e4, _mm256_srli_epi32(f, 23)), _mm256_set1_epi32(280));
+            __m256i result = _mm256_or_si256(_mm256_or_si256(sign, _mm256_slli_epi32(t, 23)), _mm256_and_si256(f, _mm256_set1_epi32(0x007fffff)));
+            result = _mm256_blendv_epi8(result, _mm256_or_si256(sign, _mm256_set1_epi32(0x7f7fffff)), _mm256_cmpgt_epi32(t, _mm256_set1_epi32(254)));
+            const __m256i zero = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(1), t), _mm256_cmpeq_epi32(fmant, _mm256_setzero_si256()));
+            return _mm256_andnot_si256(zero, result);
+        }
+        
+        __attribute__((target("avx2")))
+        inline __m256i ieee2ibmVector(__m256i v) {
+            __m256i fmant = _mm256_or_si256(_mm256_and_si256(v, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x00800000));
+            __m256i t = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0x7f800000)), 23), _mm256_set1_epi32(126));
+            const __m256i shift = _mm256_and_si256(_mm256_sub_epi32(_mm256_setzero_si256(), t), _mm256_set1_epi32(3));
+            t = _mm256_add_epi32(t, shift);
+            fmant = _mm256_srlv_epi32(fmant, shift);
+            const __m256i exponent = _mm256_slli_epi32(_mm256_add_epi32(_mm256_srai_epi32(t, 2), _mm256_set1_epi32(64)), 24);
+            const __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(v, _mm256_set1_epi32(0x80000000)), exponent), fmant);
+            return _mm256_andnot_si256(_mm256_cmpeq_epi32(v, _mm256_setzero_si256()), result);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("avx2")))
+        void ibm2ieeeAVX2(const char * source, char * destination, size_t nvalues) {
+            const __m256i mask = shuffleMask256<uint32_t>();
+            size_t ii = 0;
+            for (; ii + 8 <= nvalues; ii += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + 4 * ii));
+                if (Swap) {
+                    v = _mm256_shuffle_epi8(v, mask);
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + 4 * ii), ibm2ieeeVector(v));
+            }
+            ibm2ieeeScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("avx2")))
+        void ieee2ibmAVX2(const char * source, char * destination, size_t nvalues) {
+            const __m256i mask = shuffleMask256<uint32_t>();
+            size_t ii = 0;
+            for (; ii + 8 <= nvalues; ii += 8) {
+                __m256i v = ieee2ibmVector(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + 4 * ii)));
+                if (Swap) {
+                    v = _mm256_shuffle_epi8(v, mask);
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + 4 * ii), v);
+            }
+            ieee2ibmScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+        
+        ////////////////////
+        //// AVX-512 kernels
+        ////////////////////
+        
+        // Some GCC releases warn about _mm512_undefined_epi32, used by the 
+        // intrinsics headers for the passthrough operand of unmasked shifts
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        
+        template< class T >
+        __attribute__((target("avx512f,avx512bw")))
+        inline __m512i shuffleMask512() {
+            char mask[64];
+            for (int ii = 0; ii < 64; ++ii) {
+                mask[ii] = static_cast<char>( (ii & 15) - (ii % sizeof(T)) + (sizeof(T) - 1 - ii % sizeof(T)) );
+            }
+            return _mm512_loadu_si512(mask);
+        }
+        
+        template< class T >
+        __attribute__((target("avx512f,avx512bw")))
+        void swapAVX512(const char * source, char * destination, size_t nelements) {
+            const size_t nbytes = nelements * sizeof(T);
+            const __m512i mask = shuffleMask512<T>();
+            size_t ii = 0;
+            for (; ii + 64 <= nbytes; ii += 64) {
+                __m512i v = _mm512_loadu_si512(source + ii);
+                _mm512_storeu_si512(destination + ii, _mm512_shuffle_epi8(v, mask));
+            }
+            if (ii < nbytes) {
+                // Masked load/store of the remaining whole elements
+                const size_t tail = (nbytes - ii) / sizeof(T) * sizeof(T);
+                const __mmask64 k = _cvtu64_mask64( (static_cast<unsigned long long>(1) << tail) - 1 );
+                __m512i v = _mm512_maskz_loadu_epi8(k, source + ii);
+                _mm512_mask_storeu_epi8(destination + ii, k, _mm512_shuffle_epi8(v, mask));
+            }
+        }
+        
+        __attribute__((target("avx512f,avx512bw")))
+        inline __m512i ibm2ieeeVector(__m512i v) {
+            const __m512i sign = _mm512_and_si512(v, _mm512_set1_epi32(0x80000000));
+            const __m512i fmant = _mm512_and_si512(v, _mm512_set1_epi32(0x00ffffff));
+            const __m512i e4 = _mm512_srli_epi32(_mm512_and_si512(v, _mm512_set1_epi32(0x7f000000)), 22);
+            const __m512i f = _mm512_castps_si512(_mm512_cvtepi32_ps(fmant));
+            const __m512i t = _mm512_sub_epi32(_mm512_add_epi32(e4, _mm512_srli_epi32(f, 23)), _mm512_set1_epi32(280));
+            __m512i result = _mm512_or_si512(_mm512_or_si512(sign, _mm512_slli_epi32(t, 23)), _mm512_and_si512(f, _mm512_set1_epi32(0x007fffff)));
+            result = _mm512_mask_mov_epi32(result, _mm512_cmpgt_epi32_mask(t, _mm512_set1_epi32(254)), _mm512_or_si512(sign, _mm512_set1_epi32(0x7f7fffff)));
+            const __mmask16 nonzero = _mm512_cmpgt_epi32_mask(t, _mm512_setzero_si512()) & _mm512_test_epi32_mask(fmant, fmant);
+            return _mm512_maskz_mov_epi32(nonzero, result);
+        }
+        
+        __attribute__((target("avx512f,avx512bw")))
+        inline __m512i ieee2ibmVector(__m512i v) {
+            __m512i fmant = _mm512_or_si512(_mm512_and_si512(v, _mm512_set1_epi32(0x007fffff)), _mm512_set1_epi32(0x00800000));
+            __m512i t = _mm512_sub_epi32(_mm512_srli_epi32(_mm512_and_si512(v, _mm512_set1_epi32(0x7f800000)), 23), _mm512_set1_epi32(126));
+            const __m512i shift = _mm512_and_si512(_mm512_sub_epi32(_mm512_setzero_si512(), t), _mm512_set1_epi32(3));
+            t = _mm512_add_epi32(t, shift);
+            fmant = _mm512_srlv_epi32(fmant, shift);
+            const __m512i exponent = _mm512_slli_epi32(_mm512_add_epi32(_mm512_srai_epi32(t, 2), _mm512_set1_epi32(64)), 24);
+            const __m512i result = _mm512_or_si512(_mm512_or_si512(_mm512_and_si512(v, _mm512_set1_epi32(0x80000000)), exponent), fmant);
+            return _mm512_maskz_mov_epi32(_mm512_test_epi32_mask(v, v), result);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("avx512f,avx512bw")))
+        void ibm2ieeeAVX512(const char * source, char * destination, size_t nvalues) {
+            const __m512i mask = shuffleMask512<uint32_t>();
+            size_t ii = 0;
+            for (; ii + 16 <= nvalues; ii += 16) {
+                __m512i v = _mm512_loadu_si512(source + 4 * ii);
+                if (Swap) {
+                    v = _mm512_shuffle_epi8(v, mask);
+                }
+                _mm512_storeu_si512(destination + 4 * ii, ibm2ieeeVector(v));
+            }
+            ibm2ieeeScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+        
+        template< bool Swap >
+        __attribute__((target("avx512f,avx512bw")))
+        void ieee2ibmAVX512(const char * source, char * destination, size_t nvalues) {
+            const __m512i mask = shuffleMask512<uint32_t>();
+            size_t ii = 0;
+            for (; ii + 16 <= nvalues; ii += 16) {
+                __m512i v = ieee2ibmVector(_mm512_loadu_si512(source + 4 * ii));
+                if (Swap) {
+                    v = _mm512_shuffle_epi8(v, mask);
+                }
+                _mm512_storeu_si512(destination + 4 * ii, v);
+            }
+            ieee2ibmScalar<Swap>(source + 4 * ii, destination + 4 * ii, nvalues - ii);
+        }
+#pragma GCC diagnostic pop
+#endif
+        
+        ////////////////////
+        //// Run-time dispatch
+        ////////////////////
+        
+        struct Kernels {
+            kernel_type swap16;
+            kernel_type swap32;
+            kernel_type swap64;
+            // Indexed by the "swap bytes" flag
+            kernel_type ibm2ieee[2];
+            kernel_type ieee2ibm[2];
+            permute_kernel_type permute;
+        };
+        
+        bool supports(const InstructionSet set) {
+#ifdef SEISMIC_X86_KERNELS
+            __builtin_cpu_init();
+            switch (set) {
+                case InstructionSet::AVX512:
+                    return __builtin_cpu_supports("avx512bw");
+                case InstructionSet::AVX2:
+                    return __builtin_cpu_supports("avx2");
+                case InstructionSet::SSE2:
+                    return __builtin_cpu_supports("sse2");
+                default:
+                    return true;
+            }
+#else
+            return set == InstructionSet::Scalar;
+#endif
+        }
+        
+        Kernels makeKernels(const InstructionSet set) {
+            Kernels kernels = {
+                swapScalar<uint16_t>, swapScalar<uint32_t>, swapScalar<uint64_t>,
+                {ibm2ieeeScalar<false>, ibm2ieeeScalar<true>},
+                {ieee2ibmScalar<false>, ieee2ibmScalar<true>},
+                permuteScalar
+            };
+#ifdef SEISMIC_X86_KERNELS
+            if (set == InstructionSet::AVX512) {
+                kernels = {
+                    swapAVX512<uint16_t>, swapAVX512<uint32_t>, swapAVX512<uint64_t>,
+                    {ibm2ieeeAVX512<false>, ibm2ieeeAVX512<true>},
+                    {ieee2ibmAVX512<false>, ieee2ibmAVX512<true>},
+                    permuteSSSE3
+                };
+            } else if (set == InstructionSet::AVX2) {
+                kernels = {
+                    swapAVX2<uint16_t>, swapAVX2<uint32_t>, swapAVX2<uint64_t>,
+                    {ibm2ieeeAVX2<false>, ibm2ieeeAVX2<true>},
+                    {ieee2ibmAVX2<false>, ieee2ibmAVX2<true>},
+                    permuteSSSE3
+                };
+            } else if (set == InstructionSet::SSE2) {
+                kernels = {
+                    swapSSE2<uint16_t>, swapSSE2<uint32_t>, swapSSE2<uint64_t>,
+                    {ibm2ieeeSSE2<false>, ibm2ieeeSSE2<true>},
+                    {ieee2ibmSSE2<false>, ieee2ibmSSE2<true>},
+                    __builtin_cpu_supports("ssse3") ? permuteSSSE3 : permuteScalar
+                };
+            }
+#endif
+            return kernels;
+        }
+        
+        Kernels& kernels() {
+            static Kernels selected( makeKernels(widestInstructionSet()) );
+            return selected;
+        }
+    }
+    
+    InstructionSet widestInstructionSet() {
+        for (auto set : {InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::SSE2}) {
+            if (supports(set)) {
+                return set;
+            }
+        }
+        return InstructionSet::Scalar;
+    }
+    
+    bool selectInstructionSet(const InstructionSet set) {
+        if (!supports(set)) {
+            return false;
+        }
+        kernels() = makeKernels(set);
+        return true;
+    }
+    
+    void swapByteOrder(const char * source, char * destination, const size_t nelements, const size_t elementSize) {
+        switch (elementSize) {
+            case 1:
+                if (source != destination) {
+                    std::memcpy(destination, source, nelements);
+                }
+                break;
+            case 2:
+                kernels().swap16(source, destination, nelements);
+                break;
+            case 4:
+                kernels().swap32(source, destination, nelements);
+                break;
+            case 8:
+                kernels().swap64(source, destination, nelements);
+                break;
+            default:
+                throw std::runtime_error("Byte order error : unsupported element size\n");
+        }
+    }
+    
+    void ibm2ieee(const char * source, char * destination, const size_t nvalues, const bool swapBytes) {
+        kernels().ibm2ieee[swapBytes](source, destination, nvalues);
+    }
+    
+    void ieee2ibm(const char * source, char * destination, const size_t nvalues, const bool swapBytes) {
+        kernels().ieee2ibm[swapBytes](source, destination, nvalues);
+    }
+    
+    void permuteBytes(const char * source, char * destination, const uint8_t * permutation, const size_t size) {
+        if (size % 16 != 0) {
+            throw std::runtime_error("Byte order error : the size of a permuted stream must be a multiple of 16\n");
+        }
+        kernels().permute(source, destination, permutation, size / 16);
+    }
+    
+}
@@ -0,0 +1,317 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include<SegyFile.h>
+
+/**
+ * @file  HeaderIndex-tests.cpp
+ * @brief Unit tests for secondary indexes
+ * @test  Tests lookups by header keys for every kind of secondary index
+ */
+
+#include<boost/test/unit_test.hpp>
+
+#include<impl/SegyFile-HeaderColumns.h>
+#include<impl/utilities-inl.h>
+#include<impl/indexer/HashHeaderIndex.h>
+#include<impl/indexer/RegularGridHeaderIndex.h>
+#include<impl/indexer/SortedHeaderIndex.h>
+#include<impl/rev0/SegyFile-Fields-Rev0.h>
+
+#include<TemporaryFolder.h>
+
+#include<algorithm>
+#include<memory>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+using namespace seismic;
+
+namespace {
+  // In l10f1.sgy traces are laid out on a 50 x 2 grid of (record, trace number)
+  HeaderKey gridKey()
+  {
+    return HeaderKey(rev0::th::originalFieldRecordNumber, rev0::th::traceNumberWithinOriginalField);
+  }
+
+  // Big-endian trace header with a given (record, trace number) key
+  std::vector<char> gridHeader(const int32_t record, const int32_t trace)
+  {
+    std::vector<char> header(TraceHeader::buffer_size, 0);
+    writeBigEndian(record, header.data() + rev0::th::originalFieldRecordNumber.value_);
+    writeBigEndian(trace, header.data() + rev0::th::traceNumberWithinOriginalField.value_);
+    return header;
+  }
+
+  std::vector<std::shared_ptr<HeaderIndex> > allIndexes()
+  {
+    return {
+      std::make_shared<SortedHeaderIndex>(gridKey()),
+      std::make_shared<HashHeaderIndex>(gridKey()),
+      std::make_shared<RegularGridHeaderIndex>(gridKey())
+    };
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(HeaderIndexTest)
+BOOST_AUTO_TEST_CASE(lookups)
+{
+  for (std::string indexer : {"InMemory", "Computed"})
+  {
+    // Built while indexing, or by a catch-up pass after it
+    auto indexes=allIndexes();
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", indexer, "Stream", indexes);
+    auto attached=std::make_shared<SortedHeaderIndex>(HeaderKey(rev0::th::originalFieldRecordNumber));
+    segyFile.attachHeaderIndex(attached);
+    indexes.push_back(attached);
+    for (auto& index : indexes)
+    {
+      BOOST_REQUIRE_EQUAL(index->size(), segyFile.ntraces());
+      for (int32_t record=1; record <= 50; ++record)
+      {
+        std::vector<size_t> expected={2 * static_cast<size_t> (record) - 2, 2 * static_cast<size_t> (record) - 1};
+        auto actual=index->findFirst(record);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+        if (index->key().size() == 2)
+        {
+          actual=index->find(HeaderIndex::key_type(record, 2));
+          BOOST_REQUIRE_EQUAL(actual.size(), 1u);
+          BOOST_CHECK_EQUAL(actual.front(), expected.back());
+        }
+      }
+      BOOST_CHECK(index->find(HeaderIndex::key_type(51, 1)).empty());
+      BOOST_CHECK(index->findFirst(0).empty());
+    }
+    auto grid=std::static_pointer_cast<RegularGridHeaderIndex>(indexes[2]);
+    BOOST_CHECK(grid->firstMajor());
+    BOOST_CHECK(grid->regular());
+    BOOST_CHECK_EQUAL(grid->nruns(), 50u);
+    BOOST_CHECK_EQUAL(grid->first().min, 1);
+    BOOST_CHECK_EQUAL(grid->first().size(), 50u);
+    BOOST_CHECK_EQUAL(grid->second().stride, 1);
+    BOOST_CHECK_EQUAL(grid->second().size(), 2u);
+    auto crossline=grid->findSecond(1);
+    BOOST_REQUIRE_EQUAL(crossline.size(), 50u);
+    BOOST_CHECK_EQUAL(crossline[10], 20u);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(modifications, TemporaryCopy)
+{
+  {
+    auto indexes=allIndexes();
+    SegyFile segyFile(copy.c_str(), "Rev1", "InMemory", "Stream", indexes);
+    auto ntraces=segyFile.ntraces();
+    // Move a trace to another cell, and append one to a new record
+    auto trace=segyFile.readRawTrace(5);
+    trace.first[rev0::th::originalFieldRecordNumber]=100;
+    segyFile.overwriteRawTrace(trace, 5);
+    auto appended=segyFile.readRawTrace(5);
+    appended.first[rev0::th::originalFieldRecordNumber]=101;
+    segyFile.appendRawTrace(appended);
+    segyFile.commitTraceModifications();
+    for (auto& index : indexes)
+    {
+      BOOST_REQUIRE_EQUAL(index->size(), ntraces + 1);
+      auto moved=index->find(HeaderIndex::key_type(100, 2));
+      BOOST_REQUIRE_EQUAL(moved.size(), 1u);
+      BOOST_CHECK_EQUAL(moved.front(), 5u);
+      BOOST_CHECK_EQUAL(index->findFirst(3).size(), 1u);
+      auto last=index->findFirst(101);
+      BOOST_REQUIRE_EQUAL(last.size(), 1u);
+      BOOST_CHECK_EQUAL(last.front(), ntraces);
+    }
+    // Patch the record number of the first two traces, column-wise
+    HeaderColumns columns;
+    columns.add(rev0::th::originalFieldRecordNumber);
+    columns.resize(2);
+    columns[rev0::th::originalFieldRecordNumber][0]=1000;
+    columns[rev0::th::originalFieldRecordNumber][1]=1001;
+    segyFile.overwriteHeaderColumns(columns);
+    for (auto& index : indexes)
+    {
+      BOOST_CHECK(index->findFirst(1).empty());
+      auto patched=index->findFirst(1000);
+      BOOST_REQUIRE_EQUAL(patched.size(), 1u);
+      BOOST_CHECK_EQUAL(patched.front(), 0u);
+      BOOST_CHECK_EQUAL(index->find(HeaderIndex::key_type(1001, 2)).size(), 1u);
+    }
+  }
+}
+BOOST_AUTO_TEST_CASE(orientation)
+{
+  // A first line with a single trace doesn't tell the sort order
+  RegularGridHeaderIndex inlines(gridKey());
+  std::vector<std::pair<int32_t, int32_t> > cells={{1, 2}, {2, 1}, {2, 2}, {2, 3}, {3, 1}, {3, 2}, {3, 3}};
+  for (size_t n=0; n < cells.size(); ++n)
+  {
+    inlines.insert(n, gridHeader(cells[n].first, cells[n].second).data());
+  }
+  inlines.update();
+  BOOST_CHECK(inlines.firstMajor());
+  BOOST_CHECK_EQUAL(inlines.nruns(), 3u);
+  // Neither does a hole, even when keys arrive in separate updates
+  RegularGridHeaderIndex crosslines(gridKey());
+  cells={{2, 1}, {1, 2}, {2, 2}, {3, 2}, {1, 3}, {2, 3}, {3, 3}};
+  crosslines.insert(0, gridHeader(cells[0].first, cells[0].second).data());
+  crosslines.update();
+  for (size_t n=1; n < cells.size(); ++n)
+  {
+    crosslines.insert(n, gridHeader(cells[n].first, cells[n].second).data());
+  }
+  crosslines.update();
+  BOOST_CHECK(!crosslines.firstMajor());
+  BOOST_CHECK_EQUAL(crosslines.nruns(), 3u);
+  auto line=crosslines.findFirst(2);
+  BOOST_CHECK_EQUAL(line.size(), 3u);
+  auto cell=crosslines.find(HeaderIndex::key_type(3, 3));
+  BOOST_REQUIRE_EQUAL(cell.size(), 1u);
+  BOOST_CHECK_EQUAL(cell.front(), 6u);
+  // Keys are not retained: a replaced key is compared with, and merged into, the runs
+  crosslines.insert(5, gridHeader(2, 3).data());
+  crosslines.insert(6, gridHeader(3, 4).data());
+  crosslines.update();
+  BOOST_CHECK(crosslines.find(HeaderIndex::key_type(3, 3)).empty());
+  cell=crosslines.find(HeaderIndex::key_type(3, 4));
+  BOOST_REQUIRE_EQUAL(cell.size(), 1u);
+  BOOST_CHECK_EQUAL(cell.front(), 6u);
+  BOOST_CHECK_EQUAL(crosslines.findFirst(2).size(), 3u);
+  BOOST_CHECK(!crosslines.firstMajor());
+}
+
+BOOST_AUTO_TEST_CASE(serpentine)
+{
+  // Lines alternate direction: each of them is still a single run
+  RegularGridHeaderIndex grid(gridKey());
+  std::vector<std::pair<int32_t, int32_t> > cells;
+  for (int32_t record=1; record <= 5; ++record)
+  {
+    for (int32_t k=0; k < 4; ++k)
+    {
+      cells.emplace_back(record, record % 2 == 1 ? 10 + 2 * k : 16 - 2 * k);
+    }
+  }
+  for (size_t n=0; n < cells.size(); ++n)
+  {
+    grid.insert(n, gridHeader(cells[n].first, cells[n].second).data());
+  }
+  grid.update();
+  BOOST_CHECK(grid.firstMajor());
+  BOOST_CHECK_EQUAL(grid.nruns(), 5u);
+  BOOST_CHECK_EQUAL(grid.second().stride, 2);
+  for (size_t n=0; n < cells.size(); ++n)
+  {
+    size_t trace;
+    BOOST_REQUIRE(grid.locate(HeaderIndex::key_type(cells[n].first, cells[n].second), trace));
+    BOOST_CHECK_EQUAL(trace, n);
+  }
+  BOOST_CHECK_EQUAL(grid.findSecond(12).size(), 5u);
+  // Reversed lines fill their cells backwards
+  for (const auto& x : grid.segments())
+  {
+    for (size_t k=0; k < x.count; ++k)
+    {
+      const auto& key=cells[x.trace + k];
+      auto cell=static_cast<std::ptrdiff_t> (x.cell) + static_cast<std::ptrdiff_t> (k) * x.step;
+      BOOST_CHECK_EQUAL(cell, static_cast<std::ptrdiff_t> ((key.first - 1) * 4 + (key.second - 10) / 2));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(geometry)
+{
+  const size_t nsamples=10000;
+  auto grid=std::make_shared<RegularGridHeaderIndex>(gridKey());
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream", {grid});
+  BOOST_CHECK_EQUAL(&segyFile.geometry(), grid.get());
+  BOOST_CHECK_EQUAL(segyFile.traceIndex(7, 2), 13u);
+  BOOST_CHECK_THROW(segyFile.traceIndex(51, 1), std::out_of_range);
+  // Inline : one trace per crossline
+  std::vector<int16_t> line(2 * nsamples);
+  segyFile.readInlineAs(3, line.data(), nsamples);
+  for (size_t k=0; k < 2; ++k)
+  {
+    auto expected=segyFile.readTraceAs<int16_t>(4 + k);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), line.begin() + k * nsamples, line.begin() + (k + 1) * nsamples);
+  }
+  BOOST_CHECK_THROW(segyFile.readInlineAs(0, line.data(), nsamples), std::out_of_range);
+  // Crossline : one trace per inline
+  line.resize(50 * nsamples);
+  segyFile.readCrosslineAs(2, line.data(), nsamples);
+  for (size_t k : {0, 17, 49})
+  {
+    auto expected=segyFile.readTraceAs<int16_t>(2 * k + 1);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), line.begin() + k * nsamples, line.begin() + (k + 1) * nsamples);
+  }
+  // Time slice : one sample per cell
+  std::vector<int16_t> slice(100);
+  segyFile.readTimeSliceAs(1234, slice.data());
+  for (size_t n=0; n < slice.size(); ++n)
+  {
+    BOOST_CHECK_EQUAL(slice[n], segyFile.readTraceAs<int16_t>(n)[1234]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(geometry_with_holes, TemporaryFolder)
+{
+  const size_t nsamples=10000;
+  auto transposed=folder / "transposed.sgy";
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1");
+  {
+    // Sort traces by crossline, leaving out the cell (10, 2)
+    SegyFile output(transposed.c_str(), "Rev1");
+    output.getTextualFileHeader()=segyFile.getTextualFileHeader();
+    output.getBinaryFileHeader()=segyFile.getBinaryFileHeader();
+    output.commitFileHeaderModifications();
+    for (size_t xl=1; xl <= 2; ++xl)
+    {
+      for (size_t il=1; il <= 50; ++il)
+      {
+        if (il != 10 || xl != 2)
+        {
+          output.appendRawTrace(segyFile.readRawTrace(2 * il + xl - 3));
+        }
+      }
+    }
+  }
+  {
+    auto grid=std::make_shared<RegularGridHeaderIndex>(gridKey());
+    SegyFile holes(transposed.c_str(), "Rev1", "InMemory", "Stream", {grid});
+    BOOST_CHECK(!grid->firstMajor());
+    BOOST_CHECK_EQUAL(grid->first().size(), 50u);
+    BOOST_CHECK_EQUAL(holes.traceIndex(10, 1), 9u);
+    BOOST_CHECK_EQUAL(holes.traceIndex(11, 2), 59u);
+    BOOST_CHECK_THROW(holes.traceIndex(10, 2), std::out_of_range);
+    std::vector<int16_t> line(2 * nsamples, 1);
+    holes.readInlineAs(10, line.data(), nsamples);
+    auto expected=segyFile.readTraceAs<int16_t>(18);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), line.begin(), line.begin() + nsamples);
+    BOOST_CHECK(std::all_of(line.begin() + nsamples, line.end(), [](int16_t x) { return x == 0; }));
+    std::vector<int16_t> slice(100, 1);
+    holes.readTimeSliceAs(1234, slice.data());
+    for (size_t n=0; n < slice.size(); ++n)
+    {
+      auto value=n == 19 ? 0 : segyFile.readTraceAs<int16_t>(n)[1234];
+      BOOST_CHECK_EQUAL(slice[n], value);
+    }
+  }
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,856 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include<SegyFile.h>
+
+/**
+ * @file  SegyFile-tests.cpp
+ * @brief Unit tests for SegyFile class
+ * @test  Tests reading traces through the different backends
+ */
+
+#include<boost/test/unit_test.hpp>
+
+#include<impl/SegyFileBackend.h>
+#include<impl/SegyFile-HeaderColumns.h>
+#include<impl/SegyStreamReader.h>
+#include<impl/indexer/IndexItem-inl.h>
+#include<impl/indexer/IndexSignature-inl.h>
+#include<impl/indexer/ParallelHeaderScanner.h>
+#include<impl/rev1/SegyFile-Fields-Rev1.h>
+
+#include<TemporaryFolder.h>
+
+#include<algorithm>
+#include<atomic>
+#include<future>
+#include<limits>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<vector>
+
+using namespace seismic;
+
+BOOST_AUTO_TEST_SUITE(SegyFileTest)
+BOOST_AUTO_TEST_CASE(memory_mapped_backend)
+{
+  SegyFile stream(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream");
+  SegyFile mapped(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "MemoryMapped");
+  BOOST_REQUIRE_EQUAL(stream.ntraces(), mapped.ntraces());
+
+  for (size_t ii=0; ii < stream.ntraces(); ii += 7)
+  {
+    auto expected=stream.readRawTrace(ii);
+    auto actual=mapped.readRawTrace(ii);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expected.first.get(), expected.first.get() + TraceHeader::buffer_size,
+                                  actual.first.get(), actual.first.get() + TraceHeader::buffer_size);
+    BOOST_CHECK(expected.second == actual.second);
+
+    auto expectedTrace=stream.readTraceAs<int16_t>(ii);
+    auto actualTrace=mapped.readTraceAs<int16_t>(ii);
+    BOOST_CHECK_EQUAL_COLLECTIONS(expectedTrace.begin(), expectedTrace.end(), actualTrace.begin(), actualTrace.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(trace_view)
+{
+  SegyFile stream(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream");
+  SegyFile mapped(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "MemoryMapped");
+  BOOST_CHECK_THROW(stream.viewTrace(0), std::runtime_error);
+
+  std::vector<char> buffer;
+  std::vector<int16_t> samples;
+  for (size_t ii=0; ii < stream.ntraces(); ii += 11)
+  {
+    auto expected=stream.readTraceAs<int16_t>(ii);
+    for (auto view : {stream.viewTrace(ii, buffer), mapped.viewTrace(ii)})
+    {
+      BOOST_CHECK_EQUAL(view[rev1::th::sourceCoordinateX], expected[rev1::th::sourceCoordinateX]);
+      BOOST_CHECK_EQUAL(view[rev1::th::crosslineNumber], expected[rev1::th::crosslineNumber]);
+      BOOST_REQUIRE_EQUAL(view.size(), expected.size());
+      BOOST_CHECK_EQUAL(view.sample<int16_t>(view.size() / 2), expected[expected.size() / 2]);
+      samples.resize(view.size());
+      view.copyTo(samples.data());
+      BOOST_CHECK_EQUAL_COLLECTIONS(samples.begin(), samples.end(), expected.begin(), expected.end());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(read_into)
+{
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "MemoryMapped");
+  auto trace=segyFile.readTraceAs<int16_t>(0);
+  BOOST_CHECK_EQUAL(trace[rev1::th::nsamplesTrace], trace.size());
+  auto samples=trace.data();
+  auto header=trace.get();
+
+  SegyFile::raw_trace_type raw;
+  segyFile.readRawTraceInto(0, raw);
+  auto bytes=raw.second.data();
+  for (size_t ii=1; ii < segyFile.ntraces(); ++ii)
+  {
+    segyFile.readTraceInto(ii, trace);
+    BOOST_CHECK_EQUAL(trace.data(), samples);
+    BOOST_CHECK_EQUAL(trace.get(), header);
+    auto expected=segyFile.readTraceAs<int16_t>(ii);
+    BOOST_CHECK_EQUAL(trace[rev1::th::originalFieldRecordNumber], expected[rev1::th::originalFieldRecordNumber]);
+    BOOST_CHECK_EQUAL_COLLECTIONS(trace.begin(), trace.end(), expected.begin(), expected.end());
+
+    segyFile.readRawTraceInto(ii, raw);
+    BOOST_CHECK_EQUAL(raw.second.data(), bytes);
+    auto expectedRaw=segyFile.readRawTrace(ii);
+    BOOST_CHECK_EQUAL(raw.first[rev1::th::traceNumberWithinOriginalField], expectedRaw.first[rev1::th::traceNumberWithinOriginalField]);
+    BOOST_CHECK(raw.second == expectedRaw.second);
+  }
+  // A trace without header receives one
+  Trace<int16_t> empty((TraceHeader::smart_reference_type()));
+  BOOST_CHECK(!static_cast<TraceHeader::smart_reference_type&> (empty));
+  segyFile.readTraceInto(3, empty);
+  BOOST_REQUIRE(static_cast<TraceHeader::smart_reference_type&> (empty));
+  BOOST_CHECK_EQUAL(empty[rev1::th::originalFieldRecordNumber], segyFile.readTraceAs<int16_t>(3)[rev1::th::originalFieldRecordNumber]);
+  BOOST_CHECK_EQUAL(empty.size(), segyFile.readTraceAs<int16_t>(3).size());
+  Trace<int16_t> streamed((TraceHeader::smart_reference_type()));
+  SegyStreamReader reader(segyFile);
+  BOOST_REQUIRE(reader.next(streamed));
+  BOOST_CHECK_EQUAL(streamed[rev1::th::originalFieldRecordNumber], segyFile.readTraceAs<int16_t>(0)[rev1::th::originalFieldRecordNumber]);
+}
+
+BOOST_FIXTURE_TEST_CASE(append_traces, TemporaryFolder)
+{
+  auto path=folder / "appended.sgy";
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1");
+  {
+    SegyFile output(path.c_str(), "Rev1");
+    output.getBinaryFileHeader()=segyFile.getBinaryFileHeader();
+    output.commitFileHeaderModifications();
+    for (size_t ii=0; ii < 10; ++ii)
+    {
+      output.appendTrace(segyFile.readTraceAs<int16_t>(ii));
+      output.appendRawTrace(segyFile.readRawTrace(ii));
+    }
+    auto truncated=segyFile.readRawTrace(0);
+    truncated.second.pop_back();
+    BOOST_CHECK_THROW(output.appendRawTrace(truncated), std::runtime_error);
+    // The number of samples is unsigned: up to 65535 samples per trace
+    auto wide=segyFile.readRawTrace(0);
+    wide.first[rev1::th::nsamplesTrace]=static_cast<int16_t> (40000);
+    wide.second.resize(2 * 40000, 7);
+    output.appendRawTrace(wide);
+    output.commitTraceModifications();
+    BOOST_REQUIRE_EQUAL(output.ntraces(), 21u);
+    BOOST_CHECK(output.readRawTrace(20).second == wide.second);
+    for (size_t ii=0; ii < 20; ++ii)
+    {
+      auto expected=segyFile.readTraceAs<int16_t>(ii / 2);
+      auto trace=output.readTraceAs<int16_t>(ii);
+      BOOST_CHECK_EQUAL(trace[rev1::th::originalFieldRecordNumber], expected[rev1::th::originalFieldRecordNumber]);
+      BOOST_CHECK_EQUAL_COLLECTIONS(trace.begin(), trace.end(), expected.begin(), expected.end());
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(append_budget, TemporaryFolder)
+{
+  namespace fs=boost::filesystem;
+  auto path=folder / "budget.sgy";
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1");
+  {
+    SegyFile output(path.c_str(), "Rev1");
+    output.getTextualFileHeader()=segyFile.getTextualFileHeader();
+    output.getBinaryFileHeader()=segyFile.getBinaryFileHeader();
+    output.commitFileHeaderModifications();
+    output.setAppendMemoryBudget(64 * 1024);
+    for (size_t ii=0; ii < segyFile.ntraces(); ++ii)
+    {
+      output.appendRawTrace(segyFile.readRawTrace(ii));
+    }
+    // Chunks already on disk are not visible before the commit
+    BOOST_CHECK_EQUAL(output.ntraces(), 0u);
+    BOOST_CHECK_GT(fs::file_size(path), 3600u + 64 * 1024);
+    output.commitTraceModifications();
+    BOOST_CHECK_EQUAL(fs::file_size(path), fs::file_size(DATA_FOLDER "/l10f1.sgy"));
+    // A second round starts from the new end of the file
+    for (size_t ii=0; ii < 10; ++ii)
+    {
+      output.appendTrace(segyFile.readTraceAs<int16_t>(ii));
+    }
+    output.commitTraceModifications();
+    BOOST_REQUIRE_EQUAL(output.ntraces(), segyFile.ntraces() + 10);
+    for (size_t ii=0; ii < output.ntraces(); ++ii)
+    {
+      auto expected=segyFile.readRawTrace(ii % segyFile.ntraces());
+      auto trace=output.readRawTrace(ii);
+      BOOST_CHECK_EQUAL(trace.first[rev1::th::originalFieldRecordNumber], expected.first[rev1::th::originalFieldRecordNumber]);
+      BOOST_CHECK(trace.second == expected.second);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(overwrite_runs, TemporaryCopy)
+{
+  SegyFile reference(DATA_FOLDER "/l10f1.sgy", "Rev1");
+  const std::vector<size_t> modified={3, 4, 5, 6, 20, 40, 41, 99};
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    for (auto n : modified)
+    {
+      auto trace=segyFile.readTraceAs<int16_t>(n);
+      trace[rev1::th::sourceCoordinateX]=static_cast<int32_t> (1000 + n);
+      for (auto& sample : trace)
+      {
+        sample=static_cast<int16_t> (-sample);
+      }
+      if (n % 2 == 0)
+      {
+        segyFile.overwriteTrace(trace, n);
+      }
+      else
+      {
+        SegyFile::raw_trace_type raw(static_cast<const TraceHeader::smart_reference_type&> (trace), std::vector<char>(reinterpret_cast<const char*> (trace.data()), reinterpret_cast<const char*> (trace.data() + trace.size())));
+        segyFile.overwriteRawTrace(raw, n);
+      }
+    }
+  }
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    BOOST_REQUIRE_EQUAL(segyFile.ntraces(), reference.ntraces());
+    for (size_t n=0; n < segyFile.ntraces(); ++n)
+    {
+      auto trace=segyFile.readTraceAs<int16_t>(n);
+      auto expected=reference.readTraceAs<int16_t>(n);
+      bool isModified=std::find(modified.begin(), modified.end(), n) != modified.end();
+      BOOST_CHECK_EQUAL(trace[rev1::th::sourceCoordinateX], isModified ? 1000 + n : expected[rev1::th::sourceCoordinateX]);
+      BOOST_CHECK_EQUAL(trace[rev1::th::originalFieldRecordNumber], expected[rev1::th::originalFieldRecordNumber]);
+      BOOST_REQUIRE_EQUAL(trace.size(), expected.size());
+      for (size_t ii=0; ii < trace.size(); ii += 97)
+      {
+        BOOST_CHECK_EQUAL(trace[ii], isModified ? static_cast<int16_t> (-expected[ii]) : expected[ii]);
+      }
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(header_overwrites, TemporaryCopy)
+{
+  SegyFile reference(DATA_FOLDER "/l10f1.sgy", "Rev1");
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    // A single header
+    auto trace=segyFile.readRawTrace(7);
+    trace.first[rev1::th::sourceCoordinateX]=77;
+    segyFile.overwriteTraceHeader(trace.first, 7);
+    // A header queued after the whole trace replaces its header
+    auto other=segyFile.readRawTrace(8);
+    std::fill(other.second.begin(), other.second.end(), 0);
+    segyFile.overwriteRawTrace(other, 8);
+    auto header=segyFile.readRawTrace(8).first;
+    header[rev1::th::sourceCoordinateX]=88;
+    segyFile.overwriteTraceHeader(header, 8);
+    auto wrong=segyFile.readRawTrace(9).first;
+    wrong[rev1::th::nsamplesTrace]=static_cast<int16_t> (wrong[rev1::th::nsamplesTrace] - 1);
+    segyFile.overwriteTraceHeader(wrong, 9);
+    BOOST_CHECK_THROW(segyFile.commitTraceModifications(), std::runtime_error);
+    segyFile.overwriteTraceHeader(segyFile.readRawTrace(9).first, 9);
+    segyFile.commitTraceModifications();
+    BOOST_CHECK_EQUAL(segyFile.readRawTrace(7).first[rev1::th::sourceCoordinateX], 77);
+    BOOST_CHECK(segyFile.readRawTrace(7).second == reference.readRawTrace(7).second);
+    BOOST_CHECK_EQUAL(segyFile.readRawTrace(8).first[rev1::th::sourceCoordinateX], 88);
+    BOOST_CHECK(segyFile.readRawTrace(8).second == other.second);
+    // Queued traces and headers are copies: the caller may reuse its buffers
+    SegyFile::raw_trace_type buffer;
+    for (size_t n=0; n < 3; ++n)
+    {
+      segyFile.readRawTraceInto(n, buffer);
+      buffer.first[rev1::th::sourceCoordinateX]=static_cast<int32_t> (10 + n);
+      segyFile.overwriteTraceHeader(buffer.first, n);
+      segyFile.readRawTraceInto(n + 3, buffer);
+      buffer.first[rev1::th::sourceCoordinateX]=static_cast<int32_t> (20 + n);
+      segyFile.overwriteRawTrace(buffer, n + 3);
+    }
+    segyFile.commitTraceModifications();
+    for (size_t n=0; n < 3; ++n)
+    {
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(n).first[rev1::th::sourceCoordinateX], static_cast<int32_t> (10 + n));
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(n).first[rev1::th::originalFieldRecordNumber], reference.readRawTrace(n).first[rev1::th::originalFieldRecordNumber]);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(n + 3).first[rev1::th::sourceCoordinateX], static_cast<int32_t> (20 + n));
+      BOOST_CHECK(segyFile.readRawTrace(n + 3).second == reference.readRawTrace(n + 3).second);
+    }
+
+    // Column-wise patch of a range of traces
+    HeaderColumns columns;
+    columns.add(rev1::th::groupCoordinateX);
+    columns.add(rev1::th::scalarCoordinates);
+    columns.resize(50);
+    for (size_t ii=0; ii < columns.size(); ++ii)
+    {
+      columns[rev1::th::groupCoordinateX][ii]=static_cast<int32_t> (1000 * ii);
+      columns[rev1::th::scalarCoordinates][ii]=-100;
+    }
+    BOOST_CHECK_THROW(segyFile.overwriteHeaderColumns(columns, 51), std::out_of_range);
+    BOOST_CHECK_THROW(segyFile.overwriteHeaderColumns(columns, std::numeric_limits<size_t>::max()), std::out_of_range);
+    // The number of samples may be patched only with its current value
+    HeaderColumns nsamples;
+    nsamples.add(rev1::th::nsamplesTrace);
+    nsamples.add(rev1::th::sourceCoordinateX);
+    nsamples.resize(2);
+    nsamples[rev1::th::nsamplesTrace][0]=reference.readRawTrace(40).first[rev1::th::nsamplesTrace];
+    nsamples[rev1::th::nsamplesTrace][1]=nsamples[rev1::th::nsamplesTrace][0] - 1;
+    nsamples[rev1::th::sourceCoordinateX][0]=nsamples[rev1::th::sourceCoordinateX][1]=-1;
+    BOOST_CHECK_THROW(segyFile.overwriteHeaderColumns(nsamples, 40), std::runtime_error);
+    BOOST_CHECK_EQUAL(segyFile.readRawTrace(40).first[rev1::th::sourceCoordinateX], reference.readRawTrace(40).first[rev1::th::sourceCoordinateX]);
+    // Headers already queued are patched on top of their modifications
+    auto queued=segyFile.readRawTrace(25).first;
+    queued[rev1::th::sourceCoordinateX]=55;
+    segyFile.overwriteTraceHeader(queued, 25);
+    segyFile.overwriteHeaderColumns(columns, 20);
+    BOOST_CHECK_EQUAL(segyFile.readRawTrace(25).first[rev1::th::sourceCoordinateX], 55);
+    for (size_t n=0; n < segyFile.ntraces(); ++n)
+    {
+      auto patched=segyFile.readRawTrace(n);
+      auto expected=reference.readRawTrace(n);
+      bool inRange=n >= 20 && n < 70;
+      BOOST_CHECK_EQUAL(patched.first[rev1::th::groupCoordinateX], inRange ? static_cast<int32_t> (1000 * (n - 20)) : expected.first[rev1::th::groupCoordinateX]);
+      BOOST_CHECK_EQUAL(patched.first[rev1::th::scalarCoordinates], inRange ? -100 : expected.first[rev1::th::scalarCoordinates]);
+      BOOST_CHECK_EQUAL(patched.first[rev1::th::originalFieldRecordNumber], expected.first[rev1::th::originalFieldRecordNumber]);
+      if (n != 8)
+      {
+        BOOST_CHECK(patched.second == expected.second);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stream_reader)
+{
+  SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream");
+  const size_t traceSize=TraceHeader::buffer_size + segyFile.readTraceAs<int16_t>(0).size() * sizeof(int16_t);
+  for (auto bufferSize : {size_t(1), 3 * traceSize + 1, SegyStreamReader::default_buffer_size})
+  {
+    SegyStreamReader reader(segyFile, 0, bufferSize);
+    size_t ii=0;
+    for (const auto& trace : reader.tracesAs<int16_t>())
+    {
+      auto expected=segyFile.readTraceAs<int16_t>(ii++);
+      BOOST_CHECK_EQUAL(trace[rev1::th::originalFieldRecordNumber], expected[rev1::th::originalFieldRecordNumber]);
+      BOOST_CHECK_EQUAL(trace[rev1::th::nsamplesTrace], trace.size());
+      BOOST_REQUIRE_EQUAL(trace.size(), expected.size());
+      BOOST_CHECK(std::equal(trace.begin(), trace.end(), expected.begin()));
+    }
+    BOOST_CHECK_EQUAL(ii, segyFile.ntraces());
+    BOOST_CHECK_EQUAL(reader.position(), segyFile.ntraces());
+  }
+
+  SegyStreamReader reader(segyFile, 90, 2 * traceSize);
+  BOOST_CHECK_EQUAL(reader.position(), 90u);
+  auto wrong=reader.makeTrace<float>();
+  BOOST_CHECK_THROW(reader.next(wrong), std::runtime_error);
+  auto trace=reader.makeTrace<int16_t>();
+  BOOST_CHECK_EQUAL(reader.position(), 90u);
+  // Destroy a reader with traces still in flight
+  {
+    SegyStreamReader unfinished(segyFile, 0, traceSize);
+    BOOST_CHECK(unfinished.next(trace));
+    BOOST_CHECK_EQUAL(unfinished.position(), 1u);
+  }
+  for (size_t ii=90; ii < segyFile.ntraces(); ++ii)
+  {
+    BOOST_REQUIRE(reader.next(trace));
+    BOOST_CHECK_EQUAL(trace[rev1::th::traceNumberWithinOriginalField], ii % 2 + 1);
+  }
+  BOOST_CHECK(!reader.next(trace));
+  BOOST_CHECK(!reader.next(trace));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_reads)
+{
+  SegyFile reference(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream");
+  std::vector< std::vector<int16_t> > expected;
+  for (size_t ii=0; ii < reference.ntraces(); ++ii)
+  {
+    auto trace=reference.readTraceAs<int16_t>(ii);
+    expected.emplace_back(trace.begin(), trace.end());
+  }
+
+  for (auto backend : {"Positional", "MemoryMapped"})
+  {
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", backend);
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> workers;
+    const size_t nworkers=4;
+    for (size_t jj=0; jj < nworkers; ++jj)
+    {
+      workers.emplace_back([&, jj]()
+      {
+        for (size_t ii=jj; ii < segyFile.ntraces(); ii += nworkers)
+        {
+          auto trace=segyFile.readTraceAs<int16_t>(ii);
+          if (!std::equal(trace.begin(), trace.end(), expected[ii].begin()))
+          {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(async_reads)
+{
+  SegyFile reference(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", "Stream");
+  for (auto backend : {"Async", "Stream"})
+  {
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", backend);
+    std::vector< std::future< Trace<int16_t> > > pending;
+    for (size_t ii=segyFile.ntraces(); ii > 0; --ii)
+    {
+      pending.push_back(segyFile.readTraceAsync<int16_t>(ii - 1));
+    }
+    for (size_t ii=0; ii < pending.size(); ++ii)
+    {
+      auto trace=pending[ii].get();
+      auto expected=reference.readTraceAs<int16_t>(segyFile.ntraces() - 1 - ii);
+      BOOST_CHECK_EQUAL(trace[rev1::th::originalFieldRecordNumber], expected[rev1::th::originalFieldRecordNumber]);
+      BOOST_CHECK_EQUAL(trace[rev1::th::nsamplesTrace], trace.size());
+      BOOST_REQUIRE_EQUAL(trace.size(), expected.size());
+      BOOST_CHECK(std::equal(trace.begin(), trace.end(), expected.begin()));
+    }
+  }
+
+  // Reads past the end of the file complete with an error
+  auto backend=SegyFileBackend::create("Async");
+  backend->reset_segy_file(reference);
+  auto fileSize=boost::filesystem::file_size(reference.path());
+  std::vector<char> buffer(100);
+  std::promise<std::exception_ptr> result;
+  backend->readAsync(fileSize - 10, buffer.data(), buffer.size(), [&](std::exception_ptr error)
+  {
+    result.set_value(error);
+  });
+  BOOST_CHECK(result.get_future().get() != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(range_read, TemporaryCopy)
+{
+  for (auto backend : {"Stream", "MemoryMapped"})
+  {
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", backend);
+    const size_t first=3, count=20, stride=segyFile.readTraceAs<int16_t>(0).size() + 5;
+    std::vector<int16_t> samples(count * stride, -1);
+    std::vector<char> headers(count * TraceHeader::buffer_size);
+    segyFile.readTracesAs(first, count, samples.data(), stride, headers.data());
+    for (size_t ii=0; ii < count; ++ii)
+    {
+      auto expected=segyFile.readTraceAs<int16_t>(first + ii);
+      BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+                                    samples.begin() + ii * stride, samples.begin() + ii * stride + expected.size());
+      BOOST_CHECK(std::all_of(samples.begin() + ii * stride + expected.size(), samples.begin() + (ii + 1) * stride,
+                              [](int16_t x) { return x == 0; }));
+      TraceHeaderView header(&headers[ii * TraceHeader::buffer_size]);
+      BOOST_CHECK_EQUAL(header[rev1::th::traceSequenceNumberWithinSEGY], expected[rev1::th::traceSequenceNumberWithinSEGY]);
+    }
+    BOOST_CHECK_THROW(segyFile.readTracesAs(first, count, samples.data(), stride - 6), std::runtime_error);
+    BOOST_CHECK_THROW(segyFile.readTracesAs(segyFile.ntraces() - 1, 2, samples.data(), stride), std::out_of_range);
+    BOOST_CHECK_THROW(segyFile.readTracesAs(std::numeric_limits<size_t>::max(), 2, samples.data(), stride), std::out_of_range);
+  }
+  // A trace that does not fit the stride leaves the output untouched
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    auto trace=segyFile.readRawTrace(0);
+    const size_t nsamples=trace.first[rev1::th::nsamplesTrace];
+    trace.first[rev1::th::nsamplesTrace]=nsamples + 10;
+    trace.second.resize(trace.second.size() / nsamples * (nsamples + 10));
+    segyFile.appendRawTrace(trace);
+    segyFile.commitTraceModifications();
+    std::vector<int16_t> samples(3 * nsamples, -1);
+    BOOST_CHECK_THROW(segyFile.readTracesAs(segyFile.ntraces() - 3, 3, samples.data(), nsamples), std::runtime_error);
+    BOOST_CHECK(std::all_of(samples.begin(), samples.end(), [](int16_t x) { return x == -1; }));
+  }
+}
+BOOST_FIXTURE_TEST_CASE(computed_indexer, TemporaryCopy)
+{
+  {
+    SegyFile scanned(copy.c_str(), "Rev1", "InMemory");
+    SegyFile computed(copy.c_str(), "Rev1", "Computed");
+    BOOST_REQUIRE_EQUAL(scanned.ntraces(), computed.ntraces());
+    for (size_t ii=0; ii < scanned.ntraces(); ii += 5)
+    {
+      auto expected=scanned.readRawTrace(ii);
+      auto actual=computed.readRawTrace(ii);
+      BOOST_CHECK_EQUAL_COLLECTIONS(expected.first.get(), expected.first.get() + TraceHeader::buffer_size,
+                                    actual.first.get(), actual.first.get() + TraceHeader::buffer_size);
+      BOOST_CHECK(expected.second == actual.second);
+    }
+    BOOST_CHECK_THROW(computed.readRawTrace(computed.ntraces()), std::out_of_range);
+  }
+  // Append traces with the same length, then a shorter one
+  size_t ntraces(0), nsamples(0);
+  {
+    SegyFile computed(copy.c_str(), "Rev1", "Computed");
+    ntraces=computed.ntraces();
+    auto trace=computed.readRawTrace(0);
+    nsamples=trace.second.size() / 2;
+    computed.appendRawTrace(trace);
+    computed.commitTraceModifications();
+    BOOST_CHECK_EQUAL(computed.ntraces(), ntraces + 1);
+    trace.first[rev1::th::nsamplesTrace]=nsamples - 1;
+    trace.second.resize((nsamples - 1) * 2);
+    computed.appendRawTrace(trace);
+    computed.commitTraceModifications();
+    BOOST_REQUIRE_EQUAL(computed.ntraces(), ntraces + 2);
+    BOOST_CHECK_EQUAL(computed.readRawTrace(ntraces + 1).second.size(), (nsamples - 1) * 2);
+  }
+  // Traces with different lengths are detected when opening the file
+  {
+    SegyFile scanned(copy.c_str(), "Rev1", "InMemory");
+    SegyFile computed(copy.c_str(), "Rev1", "Computed");
+    BOOST_REQUIRE_EQUAL(computed.ntraces(), ntraces + 2);
+    BOOST_CHECK(scanned.readRawTrace(ntraces + 1).second == computed.readRawTrace(ntraces + 1).second);
+    BOOST_CHECK_EQUAL(computed.readRawTrace(ntraces).second.size(), nsamples * 2);
+  }
+}
+BOOST_AUTO_TEST_CASE(persistent_index)
+{
+  namespace fs=boost::filesystem;
+  for (std::string indexer : {"InFile", "MappedFile"})
+  {
+    TemporaryCopy temporary;
+    auto& copy=temporary.copy;
+    auto index=temporary.folder / "l10f1.index";
+    size_t ntraces(0), nsamples(0);
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      ntraces=segyFile.ntraces();
+      nsamples=segyFile.readRawTrace(1).second.size() / 2;
+    }
+    BOOST_REQUIRE(fs::exists(index));
+    // Tamper with an item in the middle: only a reused index exposes it
+    {
+      fs::fstream stream(index, std::ios::binary | std::ios::in | std::ios::out);
+      IndexItem item;
+      stream.seekg(sizeof (IndexSignature) + sizeof (IndexItem));
+      stream.read(reinterpret_cast<char*> (&item), sizeof (IndexItem));
+      IndexItem tampered(item.position(), 1);
+      stream.seekp(sizeof (IndexSignature) + sizeof (IndexItem));
+      stream.write(reinterpret_cast<char*> (&tampered), sizeof (IndexItem));
+    }
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      BOOST_CHECK_EQUAL(segyFile.ntraces(), ntraces);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(1).second.size(), 2u);
+      // Appended traces are indexed when the file is opened again
+      segyFile.appendRawTrace(segyFile.readRawTrace(0));
+    }
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      BOOST_CHECK_EQUAL(segyFile.ntraces(), ntraces + 1);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(1).second.size(), 2u);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(ntraces).second.size(), nsamples * 2);
+    }
+    // A SEG-Y file modified behind the back of the index triggers a full scan
+    fs::last_write_time(copy, fs::last_write_time(copy) + 10);
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      BOOST_CHECK_EQUAL(segyFile.ntraces(), ntraces + 1);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(1).second.size(), nsamples * 2);
+    }
+  }
+}
+BOOST_AUTO_TEST_CASE(append_entries)
+{
+  namespace fs=boost::filesystem;
+  for (std::string indexer : {"InMemory", "InFile", "Computed"})
+  {
+    TemporaryCopy temporary;
+    auto& copy=temporary.copy;
+    SegyFile reference(DATA_FOLDER "/l10f1.sgy", "Rev1");
+    const size_t ntraces=reference.ntraces();
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      segyFile.setAppendMemoryBudget(64 * 1024);
+      for (size_t ii=0; ii < 10; ++ii)
+      {
+        segyFile.appendRawTrace(reference.readRawTrace(ii));
+      }
+      segyFile.commitTraceModifications();
+      BOOST_REQUIRE_EQUAL(segyFile.ntraces(), ntraces + 10);
+      // A shorter trace doesn't fit a computed index
+      auto trace=reference.readRawTrace(0);
+      trace.first[rev1::th::nsamplesTrace]=3;
+      trace.second.resize(6);
+      segyFile.appendRawTrace(trace);
+      segyFile.commitTraceModifications();
+      BOOST_REQUIRE_EQUAL(segyFile.ntraces(), ntraces + 11);
+      BOOST_CHECK_EQUAL(segyFile.readRawTrace(ntraces + 10).second.size(), 6u);
+      // Bytes appended behind the back of the writer are found by a scan
+      {
+        auto extra=reference.readRawTrace(1);
+        fs::ofstream stream(copy, std::ios::binary | std::ios::app);
+        write(stream, extra.first);
+        write(stream, extra.second, extra.second.size() / 2, 2);
+      }
+      segyFile.appendRawTrace(reference.readRawTrace(2));
+      segyFile.commitTraceModifications();
+      BOOST_REQUIRE_EQUAL(segyFile.ntraces(), ntraces + 13);
+      for (size_t ii=0; ii < 10; ++ii)
+      {
+        auto expected=reference.readRawTrace(ii);
+        BOOST_CHECK(segyFile.readRawTrace(ntraces + ii).second == expected.second);
+      }
+      BOOST_CHECK(segyFile.readRawTrace(ntraces + 11).second == reference.readRawTrace(1).second);
+      BOOST_CHECK(segyFile.readRawTrace(ntraces + 12).second == reference.readRawTrace(2).second);
+    }
+    {
+      SegyFile segyFile(copy.c_str(), "Rev1", indexer);
+      BOOST_CHECK_EQUAL(segyFile.ntraces(), ntraces + 13);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(header_scan)
+{
+  namespace fs=boost::filesystem;
+  for (std::string backend : {"Stream", "MemoryMapped", "Positional"})
+  {
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1", "InMemory", backend);
+    size_t nvisited(0);
+    segyFile.scanTraceHeaders([&nvisited](const size_t n, const TraceHeaderView& header)
+    {
+      BOOST_CHECK_EQUAL(n, nvisited + 10);
+      BOOST_CHECK_EQUAL(header[rev0::th::originalFieldRecordNumber], static_cast<int32_t> (n / 2 + 1));
+      ++nvisited;
+    }, 10);
+    BOOST_CHECK_EQUAL(nvisited, segyFile.ntraces() - 10);
+  }
+  // Headers of short traces are gathered in windows
+  TemporaryFolder temporary;
+  auto path=temporary.folder / "short.sgy";
+  const size_t ntraces=5000;
+  {
+    SegyFile segyFile(DATA_FOLDER "/l10f1.sgy", "Rev1");
+    SegyFile output(path.c_str(), "Rev1");
+    output.getBinaryFileHeader()=segyFile.getBinaryFileHeader();
+    output.commitFileHeaderModifications();
+    for (size_t n=0; n < ntraces; ++n)
+    {
+      auto trace=segyFile.readRawTrace(0);
+      trace.first[rev0::th::originalFieldRecordNumber]=static_cast<int32_t> (n);
+      trace.first[rev0::th::nsamplesTrace]=static_cast<int16_t> (n % 7);
+      trace.second.resize(2 * (n % 7));
+      output.appendRawTrace(trace);
+    }
+  }
+  {
+    SegyFile segyFile(path.c_str(), "Rev1");
+    BOOST_REQUIRE_EQUAL(segyFile.ntraces(), ntraces);
+    size_t nvisited(0);
+    segyFile.scanTraceHeaders([&nvisited](const size_t n, const TraceHeaderView& header)
+    {
+      BOOST_CHECK_EQUAL(n, nvisited);
+      BOOST_CHECK_EQUAL(header[rev0::th::originalFieldRecordNumber], static_cast<int32_t> (n));
+      BOOST_CHECK_EQUAL(header[rev0::th::nsamplesTrace], static_cast<int16_t> (n % 7));
+      ++nvisited;
+    });
+    BOOST_CHECK_EQUAL(nvisited, ntraces);
+  }
+}
+BOOST_FIXTURE_TEST_CASE(header_columns, TemporaryCopy)
+{
+  namespace fs=boost::filesystem;
+  auto cache=folder / "l10f1.columns";
+  HeaderColumns columns;
+  BOOST_CHECK_EQUAL(columns.add(rev0::th::originalFieldRecordNumber), 0u);
+  BOOST_CHECK_EQUAL(columns.add(rev0::th::nsamplesTrace), 1u);
+  BOOST_CHECK_EQUAL(columns.add(rev0::th::originalFieldRecordNumber), 0u);
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    segyFile.readHeaderColumns(columns, cache);
+    BOOST_REQUIRE_EQUAL(columns.size(), segyFile.ntraces());
+    for (size_t n=0; n < columns.size(); ++n)
+    {
+      BOOST_CHECK_EQUAL(columns[rev0::th::originalFieldRecordNumber][n], static_cast<int32_t> (n / 2 + 1));
+      BOOST_CHECK_EQUAL(columns[rev0::th::nsamplesTrace][n], 10000);
+    }
+    BOOST_CHECK_THROW(columns[rev0::th::traceNumberWithinOriginalField], std::out_of_range);
+    segyFile.appendRawTrace(segyFile.readRawTrace(3));
+  }
+  BOOST_REQUIRE(fs::exists(cache));
+  // Tamper with a value: only reused columns expose it
+  {
+    fs::fstream stream(cache, std::ios::binary | std::ios::in | std::ios::out);
+    int32_t tampered(-1);
+    stream.seekp(sizeof (IndexSignature) + 2 * sizeof (uint64_t) + 2 * (sizeof (long long int) + sizeof (uint64_t)) + sizeof (int32_t));
+    stream.write(reinterpret_cast<char*> (&tampered), sizeof (tampered));
+  }
+  // Cached columns are reused, and extended with the appended trace
+  {
+    HeaderColumns cached;
+    cached.add(rev0::th::originalFieldRecordNumber);
+    cached.add(rev0::th::nsamplesTrace);
+    IndexSignature signature;
+    BOOST_REQUIRE(cached.load(cache, signature));
+    BOOST_CHECK_EQUAL(cached.size(), 100u);
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    segyFile.readHeaderColumns(cached, cache);
+    BOOST_REQUIRE_EQUAL(cached.size(), 101u);
+    BOOST_CHECK_EQUAL(cached.column(0)[1], -1);
+    BOOST_CHECK_EQUAL(cached.column(0).back(), 2);
+  }
+  // A different set of fields is not read from the cache
+  {
+    HeaderColumns other;
+    other.add(rev0::th::traceNumberWithinOriginalField);
+    IndexSignature signature;
+    BOOST_CHECK(!other.load(cache, signature));
+  }
+  // Headers patched in place before appending a trace are not taken from the cache
+  {
+    SegyFile segyFile(copy.c_str(), "Rev1");
+    HeaderColumns patch;
+    patch.add(rev0::th::originalFieldRecordNumber);
+    patch.resize(50);
+    for (size_t n=0; n < patch.size(); ++n)
+    {
+      patch[rev0::th::originalFieldRecordNumber][n]=static_cast<int32_t> (1000 + n);
+    }
+    segyFile.overwriteHeaderColumns(patch, 20);
+    segyFile.appendRawTrace(segyFile.readRawTrace(5));
+    segyFile.commitTraceModifications();
+    HeaderColumns cached;
+    cached.add(rev0::th::originalFieldRecordNumber);
+    cached.add(rev0::th::nsamplesTrace);
+    segyFile.readHeaderColumns(cached, cache);
+    BOOST_REQUIRE_EQUAL(cached.size(), 102u);
+    BOOST_CHECK_EQUAL(cached.column(0)[1], 1);
+    for (size_t n=20; n < 70; ++n)
+    {
+      BOOST_CHECK_EQUAL(cached.column(0)[n], static_cast<int32_t> (1000 + n - 20));
+    }
+    BOOST_CHECK_EQUAL(cached.column(0).back(), 3);
+  }
+  // Columns have their own format, distinct from that of index files
+  {
+    HeaderColumns cached;
+    cached.add(rev0::th::originalFieldRecordNumber);
+    cached.add(rev0::th::nsamplesTrace);
+    IndexSignature signature;
+    for (uint32_t magic : {IndexSignature::magic_number, HeaderColumns::magic_number})
+    {
+      {
+        fs::fstream stream(cache, std::ios::binary | std::ios::in | std::ios::out);
+        stream.write(reinterpret_cast<char*> (&magic), sizeof (magic));
+      }
+      BOOST_CHECK_EQUAL(cached.load(cache, signature), magic == HeaderColumns::magic_number);
+    }
+  }
+  // A corrupt trace count is rejected before allocating the columns
+  {
+    fs::fstream stream(cache, std::ios::binary | std::ios::in | std::ios::out);
+    uint64_t corrupt(uint64_t(1) << 60);
+    stream.seekp(sizeof (IndexSignature) + sizeof (uint64_t));
+    stream.write(reinterpret_cast<char*> (&corrupt), sizeof (corrupt));
+  }
+  {
+    HeaderColumns cached;
+    cached.add(rev0::th::originalFieldRecordNumber);
+    cached.add(rev0::th::nsamplesTrace);
+    IndexSignature signature;
+    BOOST_CHECK(!cached.load(cache, signature));
+    BOOST_CHECK_EQUAL(cached.size(), 0u);
+  }
+}
+BOOST_AUTO_TEST_CASE(index_item)
+{
+  const std::streamoff maxPosition=IndexItem::max_position;
+  for (std::streamoff position : {std::streamoff(0), std::streamoff(3600), maxPosition})
+  {
+    for (size_t nsamples : {0, 1, 10000, 65535})
+    {
+      IndexItem item(IndexItem::position_type(position), nsamples);
+      BOOST_CHECK_EQUAL(static_cast<std::streamoff> (item.position()), position);
+      BOOST_CHECK_EQUAL(item.nsamples(), nsamples);
+    }
+  }
+  BOOST_CHECK_THROW(IndexItem(IndexItem::position_type(maxPosition + 1), 1), std::out_of_range);
+  BOOST_CHECK_THROW(IndexItem(IndexItem::position_type(3600), 65536), std::out_of_range);
+}
+BOOST_FIXTURE_TEST_CASE(parallel_header_scan, TemporaryFolder)
+{
+  namespace fs=boost::filesystem;
+  auto path=folder / "outliers.sgy";
+  // 16-bit samples, zero-filled
+  auto writeTraces=[&path](const std::vector<size_t>& lengths)
+  {
+    fs::ifstream original(DATA_FOLDER "/l10f1.sgy", std::ios::binary);
+    std::vector<char> buffer(3600);
+    original.read(buffer.data(), buffer.size());
+    for (auto nsamples : lengths)
+    {
+      std::vector<char> trace(TraceHeader::buffer_size + 2 * nsamples, 0);
+      trace[114]=static_cast<char> (nsamples >> 8);
+      trace[115]=static_cast<char> (nsamples & 0xff);
+      buffer.insert(buffer.end(), trace.begin(), trace.end());
+    }
+    fs::ofstream(path, std::ios::binary).write(buffer.data(), buffer.size());
+  };
+  ParallelHeaderScanner scanner(path, 2, 4, 8);
+  std::vector<std::pair<std::streamoff, size_t> > traces;
+  auto sink=[&](ParallelHeaderScanner::position_type position, size_t nsamples)
+  {
+    traces.emplace_back(position, nsamples);
+  };
+  auto checkScan=[&](const std::vector<size_t>& lengths)
+  {
+    traces.clear();
+    BOOST_CHECK_EQUAL(static_cast<std::streamoff> (scanner.scan(3600, sink)), static_cast<std::streamoff> (fs::file_size(path)));
+    BOOST_REQUIRE_EQUAL(traces.size(), lengths.size());
+    std::streamoff position=3600;
+    for (size_t ii=0; ii < lengths.size(); ++ii)
+    {
+      BOOST_CHECK_EQUAL(traces[ii].first, position);
+      BOOST_CHECK_EQUAL(traces[ii].second, lengths[ii]);
+      position+=TraceHeader::buffer_size + 2 * lengths[ii];
+    }
+  };
+  // Traces much shorter than predicted are scanned over several rounds
+  std::vector<size_t> lengths(1000, 0);
+  lengths[0]=1000;
+  writeTraces(lengths);
+  checkScan(lengths);
+  // A few traces of different length in the middle
+  lengths.assign(1000, 50);
+  lengths[17]=30;
+  lengths[400]=70;
+  lengths[401]=0;
+  writeTraces(lengths);
+  checkScan(lengths);
+  // A truncated file is scanned up to a verified position
+  fs::resize_file(path, fs::file_size(path) - 10);
+  traces.clear();
+  auto stop=static_cast<std::streamoff> (scanner.scan(3600, sink));
+  BOOST_CHECK_LT(stop, static_cast<std::streamoff> (fs::file_size(path)));
+  BOOST_CHECK(traces.empty() || traces.back().first + TraceHeader::buffer_size + 2 * static_cast<std::streamoff> (traces.back().second) == stop);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file  TemporaryFolder.h
+ * @brief Fixtures for tests that write SEG-Y files
+ */
+#ifndef TEMPORARYFOLDER_H_20141104
+#define	TEMPORARYFOLDER_H_20141104
+
+#include<boost/filesystem.hpp>
+
+/**
+ * @brief Unique temporary folder, removed with everything it contains when 
+ * the fixture goes out of scope (even if the test fails)
+ */
+struct TemporaryFolder {
+  TemporaryFolder() : folder(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+  {
+    boost::filesystem::create_directories(folder);
+  }
+
+  ~TemporaryFolder()
+  {
+    boost::system::error_code error;
+    boost::filesystem::remove_all(folder, error);
+  }
+
+  TemporaryFolder(const TemporaryFolder&) = delete;
+  TemporaryFolder& operator=(const TemporaryFolder&) = delete;
+
+  boost::filesystem::path folder;
+};
+
+/**
+ * @brief Temporary folder holding a copy of l10f1.sgy, that tests may modify
+ */
+struct TemporaryCopy : TemporaryFolder {
+  TemporaryCopy() : copy(folder / "l10f1.sgy")
+  {
+    boost::filesystem::copy_file(DATA_FOLDER "/l10f1.sgy", copy);
+  }
+
+  boost::filesystem::path copy;
+};
+
+#endif	/* TEMPORARYFOLDER_H_20141104 */
@@ -0,0 +1,210 @@
+/*
+ *  SeismicTraces : another C++ library that reads files in SEG-Y format
+ * 
+ *  Copyright (C) 2014  Massimiliano Culpo
+ * 
+ *  This file is part of SeismicTraces.
+ *
+ *  SeismicTraces is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SeismicTraces is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ * 
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with SeismicTraces.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include<impl/utilities-inl.h>
+#include<impl/rev1/SegyFile-TraceHeader-Rev1.h>
+
+/**
+ * @file  utilities-tests.cpp
+ * @brief Unit tests for utility functions
+ * @test  Tests the vectorized byte order and format conversions of every instruction set 
+ *        supported by the CPU against their scalar counterparts
+ */
+
+#include<boost/test/unit_test.hpp>
+
+#include<algorithm>
+#include<cstdint>
+#include<cstring>
+#include<random>
+#include<stdexcept>
+#include<vector>
+
+namespace {
+  // Instruction sets whose kernels can run on this CPU, from the narrowest to the widest
+  std::vector<seismic::InstructionSet> supportedInstructionSets()
+  {
+    std::vector<seismic::InstructionSet> sets;
+    for (auto set : {seismic::InstructionSet::Scalar, seismic::InstructionSet::SSE2,
+                     seismic::InstructionSet::AVX2, seismic::InstructionSet::AVX512})
+    {
+      if (seismic::selectInstructionSet(set))
+      {
+        sets.push_back(set);
+      }
+    }
+    seismic::selectInstructionSet(seismic::widestInstructionSet());
+    return sets;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(UtilitiesTest)
+BOOST_AUTO_TEST_CASE(swap_byte_order)
+{
+  for (auto set : supportedInstructionSets())
+  {
+    BOOST_TEST_CONTEXT("instruction set " << static_cast<int>(set))
+    {
+      BOOST_REQUIRE(seismic::selectInstructionSet(set));
+      std::mt19937 generator(42);
+      for (size_t elementSize : {1, 2, 4, 8})
+      {
+        for (size_t nelements=0; nelements < 200; ++nelements)
+        {
+          // Offset the arrays to exercise unaligned accesses
+          for (size_t offset=0; offset < 3; ++offset)
+          {
+            std::vector<char> source(nelements * elementSize + offset);
+            for (auto& x : source)
+            {
+              x=static_cast<char>(generator());
+            }
+            std::vector<char> expected(source);
+            for (size_t ii=0; ii < nelements; ++ii)
+            {
+              seismic::invertByteOrder(&expected[offset + ii * elementSize], elementSize);
+            }
+            std::vector<char> actual(source.size(), 0);
+            seismic::swapByteOrder(source.data() + offset, actual.data() + offset, nelements, elementSize);
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin() + offset, expected.end(), actual.begin() + offset, actual.end());
+            // In place conversion
+            seismic::swapByteOrder(source.data() + offset, nelements, elementSize);
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin() + offset, expected.end(), source.begin() + offset, source.end());
+          }
+        }
+      }
+    }
+  }
+  seismic::selectInstructionSet(seismic::widestInstructionSet());
+}
+BOOST_AUTO_TEST_CASE(ibm_ieee_conversion)
+{
+  for (auto set : supportedInstructionSets())
+  {
+    BOOST_TEST_CONTEXT("instruction set " << static_cast<int>(set))
+    {
+      BOOST_REQUIRE(seismic::selectInstructionSet(set));
+      std::mt19937 generator(42);
+      // Zeros, smallest and largest mantissas, overflow and underflow
+      const std::vector<uint32_t> edges = {
+        0x00000000, 0x80000000, 0x00000001, 0x00ffffff, 0x41100000, 0xc1100000,
+        0x7fffffff, 0xffffffff, 0x60100000, 0x21000001, 0x3f800000, 0x7f7fffff,
+        0x00800000, 0x00400000, 0x7f800000, 0x01000000
+      };
+      for (size_t nvalues=0; nvalues < 100; ++nvalues)
+      {
+        for (size_t offset=0; offset < 3; ++offset)
+        {
+          for (bool swapBytes : {false, true})
+          {
+            std::vector<char> source((nvalues + offset) * sizeof (uint32_t));
+            std::vector<int32_t> values(nvalues);
+            for (size_t ii=0; ii < nvalues; ++ii)
+            {
+              values[ii]=static_cast<int32_t>(ii < edges.size() ? edges[ii] : generator());
+            }
+            std::memcpy(source.data() + offset, values.data(), nvalues * sizeof (uint32_t));
+            std::vector<char> actual(source.size(), 0);
+            // IBM to IEEE, swapping before the conversion
+            std::vector<int32_t> expected(values);
+            for (size_t ii=0; ii < nvalues; ++ii)
+            {
+              if (swapBytes) seismic::invertByteOrder(expected[ii]);
+              seismic::ibm2ieee(expected[ii]);
+            }
+            seismic::ibm2ieee(source.data() + offset, actual.data() + offset, nvalues, swapBytes);
+            std::vector<int32_t> converted(nvalues);
+            std::memcpy(converted.data(), actual.data() + offset, nvalues * sizeof (uint32_t));
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), converted.begin(), converted.end());
+            // IEEE to IBM, swapping after the conversion
+            expected=values;
+            for (size_t ii=0; ii < nvalues; ++ii)
+            {
+              seismic::ieee2ibm(expected[ii]);
+              if (swapBytes) seismic::invertByteOrder(expected[ii]);
+            }
+            seismic::ieee2ibm(source.data() + offset, actual.data() + offset, nvalues, swapBytes);
+            std::memcpy(converted.data(), actual.data() + offset, nvalues * sizeof (uint32_t));
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), converted.begin(), converted.end());
+          }
+        }
+      }
+    }
+  }
+  seismic::selectInstructionSet(seismic::widestInstructionSet());
+}
+BOOST_AUTO_TEST_CASE(byte_order_permutation)
+{
+  for (auto set : supportedInstructionSets())
+  {
+    BOOST_TEST_CONTEXT("instruction set " << static_cast<int>(set))
+    {
+      BOOST_REQUIRE(seismic::selectInstructionSet(set));
+      using namespace seismic;
+      static_assert(rev0::th::nsamplesTrace.value_ == 114, "Field offsets are known at compile time");
+      std::vector<char> original(TraceHeader::buffer_size);
+      for (size_t ii=0; ii < original.size(); ++ii)
+      {
+        original[ii]=static_cast<char>(ii * 7 + 3);
+      }
+      auto th=TraceHeader::create("Rev1");
+      std::memcpy(th->get(), original.data(), original.size());
+      th->invertByteOrder();
+      BOOST_CHECK_EQUAL((*th)[rev0::th::traceSequenceNumberWithinLine], readBigEndian<int32_t>(original.data()));
+      BOOST_CHECK_EQUAL((*th)[rev0::th::nsamplesTrace], readBigEndian<int16_t>(original.data() + 114));
+      BOOST_CHECK_EQUAL((*th)[rev1::th::crosslineNumber], readBigEndian<int32_t>(original.data() + 192));
+      BOOST_CHECK_EQUAL((*th)[rev1::th::sourceMeasurementUnit], readBigEndian<int16_t>(original.data() + 230));
+      // Bytes that don't belong to any field are left untouched
+      BOOST_CHECK(std::equal(original.begin() + 218, original.begin() + 224, th->get() + 218));
+      BOOST_CHECK(std::equal(original.begin() + 232, original.end(), th->get() + 232));
+      // The permutation exposed by the header does the same, out of place
+      std::vector<char> permuted(TraceHeader::buffer_size);
+      BOOST_REQUIRE(th->byteOrderPermutation() != nullptr);
+      th->byteOrderPermutation()->apply(original.data(), permuted.data());
+      BOOST_CHECK(std::equal(permuted.begin(), permuted.end(), th->get()));
+      // Inverting twice restores the original stream
+      th->invertByteOrder();
+      BOOST_CHECK(std::equal(original.begin(), original.end(), th->get()));
+      // Fields that straddle a 16-byte block can't be permuted
+      ByteOrderPermutation<32> permutation;
+      BOOST_CHECK_THROW(permutation.add(Int32Field(14)), std::runtime_error);
+      BOOST_CHECK_THROW(permutation.add(Int16Field(31)), std::runtime_error);
+    }
+  }
+  seismic::selectInstructionSet(seismic::widestInstructionSet());
+}
+BOOST_AUTO_TEST_CASE(recycling_allocator)
+{
+  using namespace seismic;
+  auto prototype=TraceHeader::create("Rev1");
+  auto first=prototype->create();
+  auto second=prototype->create();
+  BOOST_CHECK_NE(first.get(), second.get());
+  (*first)[rev0::th::nsamplesTrace]=10;
+  (*second)[rev0::th::nsamplesTrace]=20;
+  BOOST_CHECK_EQUAL((*first)[rev0::th::nsamplesTrace], 10);
+  // The memory of a destroyed header is handed out again
+  auto recycled=second.get();
+  second.reset();
+  auto third=prototype->create();
+  BOOST_CHECK_EQUAL(third.get(), recycled);
+  BOOST_CHECK(std::dynamic_pointer_cast<ConcreteTraceHeader<Rev1> >(third));
+}
+BOOST_AUTO_TEST_SUITE_END()